@@ -0,0 +1,773 @@
+// Ash census: run-based connected-component labeling and canonical object counting
+#include "census.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Unstable pieces this far apart may be parts of one object (a pentadecathlon's halves get 7 apart)
+#define FRAGMENT_MAX_REACH 8
+
+// Longest canonical code: "xs9999_64x64:" plus 16 hex digits per row
+#define CODE_SIZE (32 + CENSUS_MAX_SPAN * (CENSUS_MAX_SPAN / 4))
+
+// ---------------------------------------------------------
+// String -> int hash map (open addressing, linear probing)
+// ---------------------------------------------------------
+typedef struct {
+    char **keys;
+    int *values;
+    int capacity; // Always a power of two
+    int size;
+} CodeMap;
+
+static uint64_t hash_code(const char *s) {
+    uint64_t hash = 1469598103934665603ULL;
+    while (*s) {
+        hash ^= (unsigned char)*s++;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static void map_init(CodeMap *m, int capacity) {
+    m->keys = calloc(capacity, sizeof(char *));
+    m->values = malloc(capacity * sizeof(int));
+    m->capacity = capacity;
+    m->size = 0;
+}
+
+static void map_free(CodeMap *m) {
+    for (int i = 0; i < m->capacity; i++) free(m->keys[i]);
+    free(m->keys);
+    free(m->values);
+}
+
+// Slot holding `key`, or the empty slot where it would go
+static int map_slot(const CodeMap *m, const char *key) {
+    int i = (int)(hash_code(key) & (m->capacity - 1));
+    while (m->keys[i] && strcmp(m->keys[i], key) != 0) i = (i + 1) & (m->capacity - 1);
+    return i;
+}
+
+static int map_get(const CodeMap *m, const char *key) {
+    int i = map_slot(m, key);
+    return m->keys[i] ? m->values[i] : -1;
+}
+
+static void map_put(CodeMap *m, const char *key, int value) {
+    if (2 * (m->size + 1) > m->capacity) { // Keep the load factor under 1/2
+        CodeMap grown;
+        map_init(&grown, m->capacity * 2);
+        for (int i = 0; i < m->capacity; i++) {
+            if (!m->keys[i]) continue;
+            int slot = map_slot(&grown, m->keys[i]);
+            grown.keys[slot] = m->keys[i];
+            grown.values[slot] = m->values[i];
+        }
+        grown.size = m->size;
+        free(m->keys);
+        free(m->values);
+        *m = grown;
+    }
+    int i = map_slot(m, key);
+    if (!m->keys[i]) {
+        m->keys[i] = malloc(strlen(key) + 1);
+        strcpy(m->keys[i], key);
+        m->size++;
+    }
+    m->values[i] = value;
+}
+
+// ---------------------------------------------------------
+// Small isolated patterns
+// ---------------------------------------------------------
+typedef struct {
+    int w;
+    int h;
+    unsigned char cells[CENSUS_MAX_SPAN * CENSUS_MAX_SPAN]; // Row-major, h rows of w cells
+} Pattern;
+
+static inline int pattern_get(const Pattern *p, int r, int c) {
+    return r >= 0 && r < p->h && c >= 0 && c < p->w && p->cells[r * p->w + c];
+}
+
+static int pattern_population(const Pattern *p) {
+    int pop = 0;
+    for (int i = 0; i < p->w * p->h; i++) pop += p->cells[i];
+    return pop;
+}
+
+// Step a pattern on an infinite dead plane and crop it to its bounding box.
+// (dx, dy) receives how far the box moved. Returns false if it outgrew CENSUS_MAX_SPAN.
+static bool pattern_step(const Pattern *in, Pattern *out, int *dx, int *dy) {
+    static unsigned char next[(CENSUS_MAX_SPAN + 2) * (CENSUS_MAX_SPAN + 2)];
+    int w = in->w + 2, h = in->h + 2;
+    int minR = h, maxR = -1, minC = w, maxC = -1;
+    for (int r = 0; r < h; r++) {
+        for (int c = 0; c < w; c++) {
+            int n = 0;
+            for (int i = -1; i <= 1; i++) {
+                for (int j = -1; j <= 1; j++) {
+                    if (i || j) n += pattern_get(in, r - 1 + i, c - 1 + j);
+                }
+            }
+            int value = n == 3 || (n == 2 && pattern_get(in, r - 1, c - 1));
+            next[r * w + c] = value;
+            if (value) {
+                if (r < minR) minR = r;
+                if (r > maxR) maxR = r;
+                if (c < minC) minC = c;
+                if (c > maxC) maxC = c;
+            }
+        }
+    }
+
+    if (maxR < 0) { // Died out
+        out->w = out->h = 0;
+        *dx = *dy = 0;
+        return true;
+    }
+    if (maxR - minR + 1 > CENSUS_MAX_SPAN || maxC - minC + 1 > CENSUS_MAX_SPAN) return false;
+
+    out->h = maxR - minR + 1;
+    out->w = maxC - minC + 1;
+    for (int r = 0; r < out->h; r++) {
+        memcpy(&out->cells[r * out->w], &next[(r + minR) * w + minC], out->w);
+    }
+    *dx = minC - 1;
+    *dy = minR - 1;
+    return true;
+}
+
+static bool pattern_equal(const Pattern *a, const Pattern *b) {
+    return a->w == b->w && a->h == b->h && memcmp(a->cells, b->cells, a->w * a->h) == 0;
+}
+
+// Encode the pattern under one of the 8 symmetries (bit 2: transpose, bit 0/1: flip columns/rows)
+static void pattern_encode(const Pattern *p, int symmetry, char *buf) {
+    bool transpose = symmetry & 4;
+    int w = transpose ? p->h : p->w;
+    int h = transpose ? p->w : p->h;
+    static const char hex[] = "0123456789abcdef";
+
+    buf += sprintf(buf, "%dx%d:", w, h);
+    for (int r = 0; r < h; r++) {
+        for (int c0 = 0; c0 < w; c0 += 4) {
+            int nibble = 0;
+            for (int c = c0; c < c0 + 4 && c < w; c++) {
+                int sr = transpose ? c : r;
+                int sc = transpose ? r : c;
+                if (symmetry & 1) sc = p->w - 1 - sc;
+                if (symmetry & 2) sr = p->h - 1 - sr;
+                nibble |= p->cells[sr * p->w + sc] << (c - c0);
+            }
+            *buf++ = hex[nibble];
+        }
+    }
+    *buf = '\0';
+}
+
+// ---------------------------------------------------------
+// Census state
+// ---------------------------------------------------------
+
+// Horizontal run of live cells; runs are the union-find nodes
+typedef struct {
+    int row;
+    int start;
+    int end;    // Inclusive
+    int parent;
+} Run;
+
+// One labeled object, before it is counted
+typedef struct {
+    int coordStart; // First (row, col) pair in coords, unwrapped across torus seams
+    int count;
+    int minR;
+    int maxR;
+    int minC;
+    int maxC;
+    int entry;
+    bool counted;
+    int failed;     // Bit k set: a cluster with it at reach 2 << k was tried and is not periodic
+    int visit;      // Last grouping attempt that reached it
+    int shiftR;     // Offset of the cells in that attempt's frame
+    int shiftC;
+} CensusObject;
+
+struct Census {
+    CensusEntry *entries;
+    int entryCount;
+    int entryCapacity;
+    int objectCount;
+    CodeMap byCode;  // Canonical code -> entry
+    CodeMap byShape; // Object exactly as it appeared -> entry, skips canonicalization for repeats
+    CodeMap names;   // Canonical code -> index in knownObjects
+
+    // Scratch reused between runs
+    Grid *now;
+    Grid *after;
+    Run *runs;
+    int runCapacity;
+    int *rowStart;
+    int *component;
+    int *order;
+    int *compStart;
+    int *coords;
+    int coordCount;
+    int coordCapacity;
+    CensusObject *objects;
+    int objectCapacity;
+    int *queue;
+    int *intervals;
+    Pattern phases[CENSUS_MAX_PERIOD];
+    Pattern scratch;
+};
+
+static const struct {
+    const char *name;
+    const char *rows; // 'O' alive, '.' dead, '/' separates rows
+} knownObjects[] = {
+    { "block", "OO/OO" },
+    { "beehive", ".OO./O..O/.OO." },
+    { "loaf", ".OO./O..O/.O.O/..O." },
+    { "boat", "OO./O.O/.O." },
+    { "ship", "OO./O.O/.OO" },
+    { "tub", ".O./O.O/.O." },
+    { "pond", ".OO./O..O/O..O/.OO." },
+    { "long boat", "OO../O.O./.O.O/..O." },
+    { "barge", ".O../O.O./.O.O/..O." },
+    { "mango", ".OO../O..O./.O..O/..OO." },
+    { "blinker", "OOO" },
+    { "toad", ".OOO/OOO." },
+    { "beacon", "OO../OO../..OO/..OO" },
+    { "glider", ".O./..O/OOO" },
+    { "lightweight spaceship", ".O..O/O..../O...O/OOOO." },
+};
+
+static void pattern_parse(const char *rows, Pattern *p) {
+    p->w = (int)strcspn(rows, "/");
+    p->h = 1;
+    int col = 0;
+    for (const char *s = rows; *s; s++) {
+        if (*s == '/') {
+            p->h++;
+            col = 0;
+            continue;
+        }
+        p->cells[(p->h - 1) * p->w + col++] = (*s == 'O');
+    }
+}
+
+// Evolve phases[0] until it repeats and write its canonical code. Returns the period (0 if unstable).
+static int canonicalize(Census *c, char *code, int *population) {
+    Pattern *phases = c->phases;
+    int period = 0, moveX = 0, moveY = 0;
+    for (int gen = 1; gen <= CENSUS_MAX_PERIOD; gen++) {
+        Pattern *next = gen < CENSUS_MAX_PERIOD ? &phases[gen] : &c->scratch;
+        int dx, dy;
+        if (!pattern_step(&phases[gen - 1], next, &dx, &dy) || next->w == 0) break;
+        moveX += dx;
+        moveY += dy;
+        if (pattern_equal(next, &phases[0])) {
+            period = gen;
+            break;
+        }
+    }
+
+    // Smallest encoding over every phase and symmetry
+    char best[CODE_SIZE], candidate[CODE_SIZE];
+    best[0] = '\0';
+    int phaseCount = period ? period : 1;
+    for (int ph = 0; ph < phaseCount; ph++) {
+        for (int sym = 0; sym < 8; sym++) {
+            pattern_encode(&phases[ph], sym, candidate);
+            if (best[0] == '\0' || strcmp(candidate, best) < 0) {
+                strcpy(best, candidate);
+                *population = pattern_population(&phases[ph]);
+            }
+        }
+    }
+
+    if (period == 0) {
+        sprintf(code, "xx_%s", best);
+    } else if (period == 1) {
+        sprintf(code, "xs%d_%s", *population, best);
+    } else if (moveX || moveY) {
+        sprintf(code, "xq%d_%s", period, best);
+    } else {
+        sprintf(code, "xp%d_%s", period, best);
+    }
+    return period;
+}
+
+static int add_entry(Census *c, const char *code, int population, int period) {
+    if (c->entryCount == c->entryCapacity) {
+        c->entryCapacity = c->entryCapacity ? c->entryCapacity * 2 : 32;
+        c->entries = realloc(c->entries, c->entryCapacity * sizeof(CensusEntry));
+    }
+    CensusEntry *e = &c->entries[c->entryCount];
+    e->code = malloc(strlen(code) + 1);
+    strcpy(e->code, code);
+    int known = map_get(&c->names, code);
+    e->name = known >= 0 ? knownObjects[known].name : NULL;
+    e->population = population;
+    e->period = period;
+    e->count = 0;
+    map_put(&c->byCode, code, c->entryCount);
+    return c->entryCount++;
+}
+
+Census *create_census(void) {
+    Census *c = calloc(1, sizeof(Census));
+    map_init(&c->byCode, 64);
+    map_init(&c->byShape, 64);
+    map_init(&c->names, 32);
+
+    // Known objects go through the same canonicalization, so any phase/orientation matches
+    char code[CODE_SIZE];
+    int population;
+    for (int i = 0; i < (int)(sizeof(knownObjects) / sizeof(knownObjects[0])); i++) {
+        pattern_parse(knownObjects[i].rows, &c->phases[0]);
+        canonicalize(c, code, &population);
+        map_put(&c->names, code, i);
+    }
+    return c;
+}
+
+void destroy_census(Census *census) {
+    if (!census) return;
+    for (int i = 0; i < census->entryCount; i++) free(census->entries[i].code);
+    free(census->entries);
+    map_free(&census->byCode);
+    map_free(&census->byShape);
+    map_free(&census->names);
+    destroy_grid(census->now);
+    destroy_grid(census->after);
+    free(census->runs);
+    free(census->rowStart);
+    free(census->component);
+    free(census->order);
+    free(census->compStart);
+    free(census->coords);
+    free(census->objects);
+    free(census->queue);
+    free(census->intervals);
+    free(census);
+}
+
+void census_clear(Census *census) {
+    // Entries stay known so the next batch can skip their canonicalization
+    for (int i = 0; i < census->entryCount; i++) census->entries[i].count = 0;
+    census->objectCount = 0;
+}
+
+int census_object_count(const Census *census) {
+    return census->objectCount;
+}
+
+static int compare_entries(const void *a, const void *b) {
+    const CensusEntry *x = *(const CensusEntry * const *)a, *y = *(const CensusEntry * const *)b;
+    if (x->count != y->count) return y->count - x->count;
+    return strcmp(x->code, y->code);
+}
+
+int census_summary(const Census *census, const CensusEntry **out, int max) {
+    const CensusEntry **sorted = malloc((census->entryCount + 1) * sizeof(CensusEntry *));
+    int n = 0;
+    for (int i = 0; i < census->entryCount; i++) {
+        if (census->entries[i].count > 0) sorted[n++] = &census->entries[i];
+    }
+    qsort(sorted, n, sizeof(CensusEntry *), compare_entries);
+    if (n > max) n = max;
+    memcpy(out, sorted, n * sizeof(CensusEntry *));
+    free(sorted);
+    return n;
+}
+
+// ---------------------------------------------------------
+// Labeling
+// ---------------------------------------------------------
+static int find_root(Run *runs, int i) {
+    while (runs[i].parent != i) {
+        runs[i].parent = runs[runs[i].parent].parent; // Path halving
+        i = runs[i].parent;
+    }
+    return i;
+}
+
+static void unite(Run *runs, int a, int b) {
+    a = find_root(runs, a);
+    b = find_root(runs, b);
+    if (a < b) runs[b].parent = a;
+    else if (b < a) runs[a].parent = b;
+}
+
+// Union the runs of two vertically adjacent rows that touch (diagonals included)
+static void link_rows(Census *c, int rowA, int rowB) {
+    int i = c->rowStart[rowA], iEnd = c->rowStart[rowA + 1];
+    int j = c->rowStart[rowB], jEnd = c->rowStart[rowB + 1];
+    Run *runs = c->runs;
+    while (i < iEnd && j < jEnd) {
+        if (runs[i].start <= runs[j].end + 1 && runs[j].start <= runs[i].end + 1) unite(runs, i, j);
+        if (runs[i].end < runs[j].end) i++;
+        else j++;
+    }
+}
+
+static void ensure_scratch(Census *c, const Grid *grid) {
+    if (c->now && c->now->rows == grid->rows && c->now->cols == grid->cols) return;
+    destroy_grid(c->now);
+    destroy_grid(c->after);
+    c->now = create_grid(grid->rows, grid->cols);
+    c->after = create_grid(grid->rows, grid->cols);
+    c->rowStart = realloc(c->rowStart, (grid->rows + 1) * sizeof(int));
+}
+
+static int compare_ints(const void *a, const void *b) {
+    return *(const int *)a - *(const int *)b;
+}
+
+// For an object wrapping around the left/right torus seam, the first column after its widest
+// empty gap: runs left of it are the wrapped part and move right by one grid width
+static int column_gap_end(Census *c, int first, int last) {
+    // Sorted run intervals of the component, then the widest empty gap between them
+    int n = last - first;
+    c->intervals = realloc(c->intervals, 2 * n * sizeof(int));
+    for (int k = 0; k < n; k++) {
+        const Run *r = &c->runs[c->order[first + k]];
+        c->intervals[2 * k] = r->start;
+        c->intervals[2 * k + 1] = r->end;
+    }
+    qsort(c->intervals, n, 2 * sizeof(int), compare_ints);
+
+    int covered = c->intervals[1], bestGap = 0, gapEnd = 0;
+    for (int k = 1; k < n; k++) {
+        int gap = c->intervals[2 * k] - covered - 1;
+        if (gap > bestGap) {
+            bestGap = gap;
+            gapEnd = c->intervals[2 * k];
+        }
+        if (c->intervals[2 * k + 1] > covered) covered = c->intervals[2 * k + 1];
+    }
+    return gapEnd;
+}
+
+// Collect the live cells of the object made of the runs order[first..last) into `object`
+static void census_object(Census *c, int first, int last, BoundaryMode boundary, CensusObject *object) {
+    const Grid *g = c->now;
+    int rows = g->rows, cols = g->cols;
+    const Run *firstRun = &c->runs[c->order[first]], *lastRun = &c->runs[c->order[last - 1]];
+
+    // Unwrap objects crossing the torus seams
+    int rowGapEnd = 0, colGapEnd = 0;
+    if (boundary == BOUNDARY_TORUS) {
+        if (firstRun->row == 0 && lastRun->row == rows - 1) {
+            int bestGap = 0;
+            for (int k = first + 1; k < last; k++) {
+                int gap = c->runs[c->order[k]].row - c->runs[c->order[k - 1]].row - 1;
+                if (gap > bestGap) {
+                    bestGap = gap;
+                    rowGapEnd = c->runs[c->order[k]].row;
+                }
+            }
+        }
+        bool touchesLeft = false, touchesRight = false;
+        for (int k = first; k < last; k++) {
+            touchesLeft |= c->runs[c->order[k]].start == 0;
+            touchesRight |= c->runs[c->order[k]].end == cols - 1;
+        }
+        if (touchesLeft && touchesRight) colGapEnd = column_gap_end(c, first, last);
+    }
+
+    // Live cells of the object (births only served to connect it)
+    int count = 0;
+    int minR = 0, maxR = 0, minC = 0, maxC = 0;
+    for (int k = first; k < last; k++) {
+        const Run *r = &c->runs[c->order[k]];
+        int row = r->row < rowGapEnd ? r->row + rows : r->row;
+        int shift = r->start < colGapEnd ? cols : 0;
+        for (int col = r->start; col <= r->end; col++) {
+            if (!g->cells[r->row * g->stride + col]) continue;
+            if (2 * (c->coordCount + 1) > c->coordCapacity) {
+                c->coordCapacity = c->coordCapacity ? c->coordCapacity * 2 : 256;
+                c->coords = realloc(c->coords, c->coordCapacity * sizeof(int));
+            }
+            c->coords[2 * c->coordCount] = row;
+            c->coords[2 * c->coordCount + 1] = col + shift;
+            c->coordCount++;
+            if (count == 0 || row < minR) minR = row;
+            if (count == 0 || row > maxR) maxR = row;
+            if (count == 0 || col + shift < minC) minC = col + shift;
+            if (count == 0 || col + shift > maxC) maxC = col + shift;
+            count++;
+        }
+    }
+    *object = (CensusObject){ .coordStart = c->coordCount - count, .count = count,
+                              .minR = minR, .maxR = maxR, .minC = minC, .maxC = maxC, .visit = -1 };
+}
+
+static bool fits_span(int minR, int maxR, int minC, int maxC) {
+    return maxR - minR + 1 <= CENSUS_MAX_SPAN && maxC - minC + 1 <= CENSUS_MAX_SPAN;
+}
+
+// Add the object's cells, moved by its cluster shift, to phases[0] whose top-left is (minR, minC)
+static void stamp_object(Census *c, const CensusObject *o, int minR, int minC) {
+    Pattern *p = &c->phases[0];
+    for (int i = o->coordStart; i < o->coordStart + o->count; i++) {
+        p->cells[(c->coords[2 * i] + o->shiftR - minR) * p->w + c->coords[2 * i + 1] + o->shiftC - minC] = 1;
+    }
+}
+
+// Entry for the pattern in phases[0], canonicalizing it unless this exact shape was seen before
+static int pattern_entry(Census *c) {
+    char shape[CODE_SIZE];
+    pattern_encode(&c->phases[0], 0, shape);
+    int entry = map_get(&c->byShape, shape);
+    if (entry < 0) {
+        char code[CODE_SIZE];
+        int population;
+        int period = canonicalize(c, code, &population);
+        entry = map_get(&c->byCode, code);
+        if (entry < 0) entry = add_entry(c, code, population, period);
+        map_put(&c->byShape, shape, entry);
+    }
+    return entry;
+}
+
+static void object_entry(Census *c, CensusObject *o) {
+    if (!fits_span(o->minR, o->maxR, o->minC, o->maxC)) {
+        o->entry = map_get(&c->byCode, "xx_large");
+        if (o->entry < 0) o->entry = add_entry(c, "xx_large", o->count, 0);
+        return;
+    }
+    Pattern *p = &c->phases[0];
+    p->h = o->maxR - o->minR + 1;
+    p->w = o->maxC - o->minC + 1;
+    memset(p->cells, 0, p->w * p->h);
+    stamp_object(c, o, o->minR, o->minC);
+    o->entry = pattern_entry(c);
+}
+
+// Unstable pieces that may be part of a bigger object (not the ones too large to evolve)
+static bool is_fragment(const Census *c, const CensusObject *o) {
+    return c->entries[o->entry].period == 0 && fits_span(o->minR, o->maxR, o->minC, o->maxC);
+}
+
+// Whether some cell of b, moved by (*dr, *dc), is within `reach` cells of a cell of a.
+// On a torus b may be found a whole grid height/width away, the move is returned.
+static bool objects_near(const Census *c, const CensusObject *a, const CensusObject *b, int reach,
+                         BoundaryMode boundary, int *dr, int *dc) {
+    int rows = c->now->rows, cols = c->now->cols;
+    int wraps = boundary == BOUNDARY_TORUS ? 3 : 1;
+    static const int sign[3] = { 0, -1, 1 };
+    for (int i = 0; i < wraps; i++) {
+        for (int j = 0; j < wraps; j++) {
+            int moveR = sign[i] * rows, moveC = sign[j] * cols;
+            if (b->minR + moveR > a->maxR + reach || b->maxR + moveR < a->minR - reach ||
+                b->minC + moveC > a->maxC + reach || b->maxC + moveC < a->minC - reach) continue;
+            for (int p = a->coordStart; p < a->coordStart + a->count; p++) {
+                for (int q = b->coordStart; q < b->coordStart + b->count; q++) {
+                    if (abs(c->coords[2 * q] + moveR - c->coords[2 * p]) <= reach &&
+                        abs(c->coords[2 * q + 1] + moveC - c->coords[2 * p + 1]) <= reach) {
+                        *dr = moveR;
+                        *dc = moveC;
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+    return false;
+}
+
+// Write `value` into `map` at every cell of the object
+static void paint_object(const Census *c, Grid *map, const CensusObject *o, int value) {
+    for (int i = o->coordStart; i < o->coordStart + o->count; i++) {
+        map->cells[(c->coords[2 * i] % map->rows) * map->stride + c->coords[2 * i + 1] % map->cols] = value;
+    }
+}
+
+// Gather the uncounted fragments within `reach` of each other, starting from `start`, into queue.
+// `map` holds 1 + the index of the fragment at each fragment cell. Returns the cluster size,
+// or 0 once it can no longer fit CENSUS_MAX_SPAN (queue then holds the pieces gathered so far
+// in *size).
+static int gather_cluster(Census *c, const Grid *map, int start, int reach, int attempt, BoundaryMode boundary,
+                          int *size) {
+    CensusObject *objects = c->objects;
+    int rows = map->rows, cols = map->cols;
+    CensusObject *o = &objects[start];
+    int minR = o->minR, maxR = o->maxR, minC = o->minC, maxC = o->maxC;
+    *size = 0;
+    o->visit = attempt;
+    o->shiftR = o->shiftC = 0;
+    c->queue[(*size)++] = start;
+    for (int head = 0; head < *size; head++) {
+        const CensusObject *from = &objects[c->queue[head]];
+        // Everything within reach lies in its bounding box grown by reach
+        for (int r = from->minR - reach; r <= from->maxR + reach; r++) {
+            int row = r;
+            if (boundary == BOUNDARY_TORUS) row = ((row % rows) + rows) % rows;
+            else if (row < 0 || row >= rows) continue;
+            const int *mapRow = map->cells + row * map->stride;
+            for (int cc = from->minC - reach; cc <= from->maxC + reach; cc++) {
+                int col = cc;
+                if (boundary == BOUNDARY_TORUS) {
+                    if (col < 0 || col >= cols) col = ((col % cols) + cols) % cols;
+                } else if (col < 0 || col >= cols) {
+                    continue;
+                }
+                int j = mapRow[col] - 1;
+                if (j < 0 || objects[j].visit == attempt || objects[j].counted) continue;
+                CensusObject *to = &objects[j];
+                int dr, dc;
+                if (!objects_near(c, from, to, reach, boundary, &dr, &dc)) continue;
+                to->visit = attempt;
+                to->shiftR = from->shiftR + dr;
+                to->shiftC = from->shiftC + dc;
+                c->queue[(*size)++] = j;
+                if (to->minR + to->shiftR < minR) minR = to->minR + to->shiftR;
+                if (to->maxR + to->shiftR > maxR) maxR = to->maxR + to->shiftR;
+                if (to->minC + to->shiftC < minC) minC = to->minC + to->shiftC;
+                if (to->maxC + to->shiftC > maxC) maxC = to->maxC + to->shiftC;
+                if (!fits_span(minR, maxR, minC, maxC)) return 0;
+            }
+        }
+    }
+
+    Pattern *p = &c->phases[0];
+    p->h = maxR - minR + 1;
+    p->w = maxC - minC + 1;
+    memset(p->cells, 0, p->w * p->h);
+    for (int k = 0; k < *size; k++) stamp_object(c, &objects[c->queue[k]], minR, minC);
+    return *size;
+}
+
+// Count the objects. Some objects are disconnected in certain phases (the spark cell of a
+// spaceship, the quarters of a pulsar) and their pieces look unstable on their own: unstable
+// pieces close to each other are tried together, nearest first, and count as one object if
+// that turns out periodic.
+static void count_objects(Census *c, int objectCount, BoundaryMode boundary) {
+    CensusObject *objects = c->objects;
+    Grid *map = c->after; // Free once labeling is done
+    int fragments = 0;
+    for (int i = 0; i < objectCount; i++) {
+        CensusObject *o = &objects[i];
+        if (is_fragment(c, o)) {
+            fragments++;
+            continue;
+        }
+        o->counted = true;
+        c->entries[o->entry].count++;
+        c->objectCount++;
+    }
+    if (fragments == 0) return;
+    // The map still holds the next generation, clear it before marking the fragments
+    memset(&map->cells[-map->stride - 1], 0, (map->rows + 2) * map->stride * sizeof(int));
+    for (int i = 0; i < objectCount; i++) {
+        if (is_fragment(c, &objects[i])) paint_object(c, map, &objects[i], i + 1);
+    }
+
+    int attempt = 0;
+    for (int i = 0; i < objectCount; i++) {
+        if (objects[i].counted) continue;
+        for (int k = 0, reach = 2; reach <= FRAGMENT_MAX_REACH && !objects[i].counted; k++, reach *= 2) {
+            // A piece already tried in a cluster at this reach would gather the same pieces again
+            if (objects[i].failed & (1 << k)) continue;
+            int size;
+            int entry = gather_cluster(c, map, i, reach, attempt++, boundary, &size) > 1 ? pattern_entry(c) : -1;
+            if (entry >= 0 && c->entries[entry].period > 0) {
+                for (int m = 0; m < size; m++) objects[c->queue[m]].counted = true;
+                c->entries[entry].count++;
+                c->objectCount++;
+            } else {
+                for (int m = 0; m < size; m++) objects[c->queue[m]].failed |= 1 << k;
+            }
+        }
+        if (!objects[i].counted) { // Really unstable: count the piece as it is
+            objects[i].counted = true;
+            c->entries[objects[i].entry].count++;
+            c->objectCount++;
+        }
+    }
+}
+
+int census_run(Census *census, const Grid *grid, BoundaryMode boundary) {
+    Census *c = census;
+    int rows = grid->rows, cols = grid->cols;
+    ensure_scratch(c, grid);
+
+    // Objects are connected through the cells of this generation *and* the next one,
+    // so pieces that interact in the next step (e.g. the halves of a beacon) stay together
+    copy_grid(grid, c->now);
+    next_generation(c->now, c->after, boundary, NULL);
+
+    // Runs of live cells, row by row
+    int runCount = 0;
+    for (int x = 0; x < rows; x++) {
+        c->rowStart[x] = runCount;
+        const int *now = &c->now->cells[x * c->now->stride];
+        const int *after = &c->after->cells[x * c->after->stride];
+        for (int y = 0; y < cols; ) {
+            if (!(now[y] | after[y])) { y++; continue; }
+            int start = y;
+            while (y < cols && (now[y] | after[y])) y++;
+            if (runCount == c->runCapacity) {
+                c->runCapacity = c->runCapacity ? c->runCapacity * 2 : 1024;
+                c->runs = realloc(c->runs, c->runCapacity * sizeof(Run));
+            }
+            c->runs[runCount] = (Run){ .row = x, .start = start, .end = y - 1, .parent = runCount };
+            runCount++;
+        }
+    }
+    c->rowStart[rows] = runCount;
+    if (runCount == 0) return 0;
+
+    for (int x = 1; x < rows; x++) link_rows(c, x - 1, x);
+    if (boundary == BOUNDARY_TORUS) {
+        if (rows > 2) link_rows(c, rows - 1, 0);
+        // Runs touching the left edge against runs touching the right edge, one row up/down included
+        for (int x = 0; x < rows; x++) {
+            int left = c->rowStart[x];
+            if (left == c->rowStart[x + 1] || c->runs[left].start != 0) continue;
+            for (int dx = -1; dx <= 1; dx++) {
+                int r = (x + dx + rows) % rows;
+                int right = c->rowStart[r + 1] - 1;
+                if (right >= c->rowStart[r] && c->runs[right].end == cols - 1) unite(c->runs, left, right);
+            }
+        }
+    }
+
+    // Group runs by component (counting sort keeps them in row order)
+    c->component = realloc(c->component, runCount * sizeof(int));
+    c->order = realloc(c->order, runCount * sizeof(int));
+    c->compStart = realloc(c->compStart, (runCount + 1) * sizeof(int));
+    int compCount = 0;
+    for (int i = 0; i < runCount; i++) c->component[i] = -1;
+    for (int i = 0; i < runCount; i++) {
+        int root = find_root(c->runs, i);
+        if (c->component[root] < 0) c->component[root] = compCount++;
+        c->component[i] = c->component[root];
+    }
+    memset(c->compStart, 0, (compCount + 1) * sizeof(int));
+    for (int i = 0; i < runCount; i++) c->compStart[c->component[i] + 1]++;
+    for (int k = 0; k < compCount; k++) c->compStart[k + 1] += c->compStart[k];
+    for (int i = 0; i < runCount; i++) c->order[c->compStart[c->component[i]]++] = i;
+    for (int k = compCount; k > 0; k--) c->compStart[k] = c->compStart[k - 1];
+    c->compStart[0] = 0;
+
+    if (compCount > c->objectCapacity) {
+        c->objectCapacity = compCount;
+        c->objects = realloc(c->objects, compCount * sizeof(CensusObject));
+        c->queue = realloc(c->queue, compCount * sizeof(int));
+    }
+    c->coordCount = 0;
+    for (int k = 0; k < compCount; k++) {
+        census_object(c, c->compStart[k], c->compStart[k + 1], boundary, &c->objects[k]);
+        object_entry(c, &c->objects[k]);
+    }
+    int counted = c->objectCount;
+    count_objects(c, compCount, boundary);
+    return c->objectCount - counted;
+}
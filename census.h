@@ -0,0 +1,53 @@
+#ifndef CENSUS_H
+#define CENSUS_H
+
+#include <stdbool.h>
+
+#include "game.h"
+
+#define CENSUS_MAX_PERIOD 32  // Objects not repeating within this many generations count as unstable
+#define CENSUS_MAX_SPAN 64    // Larger objects are not evolved, just counted as unstable
+
+// One kind of object and how many times it was seen
+typedef struct {
+ char *code;        // Canonical code, e.g. "xs4_2x2:33" (prefix xs = still life, xp = oscillator, xq = spaceship, xx = unstable)
+ const char *name;  // Common name ("block", "glider"...) or NULL if unknown
+ int population;    // Live cells in the canonical phase
+ int period;        // 1 for still lifes, 0 for unstable objects
+ int count;
+} CensusEntry;
+
+typedef struct Census Census;
+
+/**
+ * Create an empty census. A census accumulates counts over any number of census_run calls.
+ */
+Census *create_census(void);
+void destroy_census(Census *census);
+
+/**
+ * Reset all counts (keeps the internal buffers for the next run).
+ */
+void census_clear(Census *census);
+
+/**
+ * Split the grid into objects (wrapping around when boundary is a torus) and add each one to the
+ * counts, canonicalized under rotations, reflections and phase. Pieces that touch now or in the
+ * next generation are one object; pieces that are not periodic on their own are tried together
+ * with the unstable pieces near them, so an object is counted whole in every phase even where it
+ * is disconnected (spaceships, pulsars, pentadecathlons).
+ * Returns the number of objects found in this grid.
+ */
+int census_run(Census *census, const Grid *grid, BoundaryMode boundary);
+
+/**
+ * Fill `out` with up to `max` entries, most common first. Returns how many were written.
+ */
+int census_summary(const Census *census, const CensusEntry **out, int max);
+
+/**
+ * Total number of objects counted since the last census_clear.
+ */
+int census_object_count(const Census *census);
+
+#endif // CENSUS_H
@@ -1,8 +1,11 @@
 // Optimized game.c
+#define _POSIX_C_SOURCE 200809L // pthreads
 #include "game.h"
+#include <pthread.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 // ---------------------------------------------------------
 // Create / Destroy
@@ -11,136 +14,471 @@ Grid *create_grid(int rows, int cols) {
     Grid *g = (Grid *)malloc(sizeof(Grid));
     g->rows = rows;
     g->cols = cols;
-    g->cells = calloc(rows * cols, sizeof(int)); // calloc initializes memory to zero
+    g->stride = cols + 2;
+    int *storage = calloc((rows + 2) * g->stride, sizeof(int)); // calloc initializes memory to zero
+    g->cells = storage + g->stride + 1; // Skip the top halo row and the left halo cell
     return g;
 }
 
+// Start of the allocation, including the halo
+static inline int *grid_storage(const Grid *g) {
+    return g->cells - g->stride - 1;
+}
+
 void destroy_grid(Grid *grid) {
     if (!grid) return;
-    free(grid->cells);
+    free(grid_storage(grid));
     free(grid);
 }
 
+DirtyTiles *create_dirty_tiles(int rows, int cols) {
+    DirtyTiles *d = (DirtyTiles *)malloc(sizeof(DirtyTiles));
+    d->tileRows = (rows + DIRTY_TILE_SIZE - 1) / DIRTY_TILE_SIZE;
+    d->tileCols = (cols + DIRTY_TILE_SIZE - 1) / DIRTY_TILE_SIZE;
+    d->tiles = malloc(d->tileRows * d->tileCols);
+    mark_all_dirty(d);
+    return d;
+}
+
+void destroy_dirty_tiles(DirtyTiles *dirty) {
+    if (!dirty) return;
+    free(dirty->tiles);
+    free(dirty);
+}
+
+void mark_all_dirty(DirtyTiles *dirty) {
+    memset(dirty->tiles, 1, dirty->tileRows * dirty->tileCols);
+}
+
+void mark_cell_dirty(DirtyTiles *dirty, int row, int col) {
+    dirty->tiles[(row / DIRTY_TILE_SIZE) * dirty->tileCols + col / DIRTY_TILE_SIZE] = 1;
+}
+
+bool any_tile_dirty(const DirtyTiles *dirty) {
+    for (int i = 0; i < dirty->tileRows * dirty->tileCols; i++) {
+        if (dirty->tiles[i]) return true;
+    }
+    return false;
+}
+
 // ---------------------------------------------------------
 // Helpers
 // ---------------------------------------------------------
 void clear_grid(Grid *grid) {
-    memset(grid->cells, 0, grid->rows * grid->cols * sizeof(int));
+    memset(grid_storage(grid), 0, (grid->rows + 2) * grid->stride * sizeof(int));
 }
 
 void randomize_grid(Grid *grid) {
-    for (int i = 0; i < grid->rows * grid->cols; i++) {
-        grid->cells[i] = rand() % 2;
+    for (int x = 0; x < grid->rows; x++) {
+        for (int y = 0; y < grid->cols; y++) {
+            grid->cells[x * grid->stride + y] = rand() % 2;
+        }
     }
 }
 
 static inline int idx(const Grid *g, int row, int col) {
-    return row * g->cols + col;
+    return row * g->stride + col;
 }
 
-int count_neighbors(const Grid *grid, int x, int y) {
-    static const int offsets[] = {-1, 0, 1};
-    int count = 0;
-    for (int dx = 0; dx < 3; dx++) {
-        for (int dy = 0; dy < 3; dy++) {
-            if (dx == 1 && dy == 1) continue; // Skip the current cell
-            int nx = (x + offsets[dx] + grid->rows) % grid->rows;
-            int ny = (y + offsets[dy] + grid->cols) % grid->cols;
-            count += grid->cells[idx(grid, nx, ny)];
-        }
+// ---------------------------------------------------------
+// Halo fill (one routine per boundary mode)
+// ---------------------------------------------------------
+static void fill_halo_torus(Grid *g) {
+    int rows = g->rows, cols = g->cols;
+    for (int x = 0; x < rows; x++) {
+        g->cells[idx(g, x, -1)] = g->cells[idx(g, x, cols - 1)];
+        g->cells[idx(g, x, cols)] = g->cells[idx(g, x, 0)];
     }
-    return count;
+    // Whole halo rows, including the side halo cells just filled, so the corners wrap too
+    memcpy(&g->cells[idx(g, -1, -1)], &g->cells[idx(g, rows - 1, -1)], g->stride * sizeof(int));
+    memcpy(&g->cells[idx(g, rows, -1)], &g->cells[idx(g, 0, -1)], g->stride * sizeof(int));
 }
 
-void next_generation(const Grid *current, Grid *next) {
-    int rows = current->rows, cols = current->cols;
+static void fill_halo_dead(Grid *g) {
+    int rows = g->rows, cols = g->cols;
     for (int x = 0; x < rows; x++) {
+        g->cells[idx(g, x, -1)] = 0;
+        g->cells[idx(g, x, cols)] = 0;
+    }
+    memset(&g->cells[idx(g, -1, -1)], 0, g->stride * sizeof(int));
+    memset(&g->cells[idx(g, rows, -1)], 0, g->stride * sizeof(int));
+}
+
+static void fill_halo_mirror(Grid *g) {
+    int rows = g->rows, cols = g->cols;
+    for (int x = 0; x < rows; x++) {
+        g->cells[idx(g, x, -1)] = g->cells[idx(g, x, 0)];
+        g->cells[idx(g, x, cols)] = g->cells[idx(g, x, cols - 1)];
+    }
+    memcpy(&g->cells[idx(g, -1, -1)], &g->cells[idx(g, 0, -1)], g->stride * sizeof(int));
+    memcpy(&g->cells[idx(g, rows, -1)], &g->cells[idx(g, rows - 1, -1)], g->stride * sizeof(int));
+}
+
+void fill_halo(Grid *grid, BoundaryMode boundary) {
+    switch (boundary) {
+        case BOUNDARY_DEAD:   fill_halo_dead(grid); break;
+        case BOUNDARY_MIRROR: fill_halo_mirror(grid); break;
+        default:              fill_halo_torus(grid); break;
+    }
+}
+
+int count_neighbors(const Grid *grid, int x, int y) {
+    const int *above = &grid->cells[idx(grid, x - 1, y)];
+    const int *row   = &grid->cells[idx(grid, x, y)];
+    const int *below = &grid->cells[idx(grid, x + 1, y)];
+    return above[-1] + above[0] + above[1] +
+           row[-1]              + row[1] +
+           below[-1] + below[0] + below[1];
+}
+
+// Per-cell counting over rows [x0, x1), the halo of current must already be filled
+static void step_rows_counting(const Grid *current, Grid *next, int x0, int x1, DirtyTiles *dirty) {
+    int cols = current->cols, stride = current->stride;
+    for (int x = x0; x < x1; x++) {
+        const int *above = &current->cells[idx(current, x - 1, 0)];
+        const int *row   = above + stride;
+        const int *below = row + stride;
+        int *out = &next->cells[idx(next, x, 0)];
+        // Tile flags for this row (NULL when the caller doesn't track changes)
+        unsigned char *tileRow = dirty ? dirty->tiles + (x / DIRTY_TILE_SIZE) * dirty->tileCols : NULL;
         for (int y = 0; y < cols; y++) {
-            int neighbors = count_neighbors(current, x, y);
-            next->cells[idx(next, x, y)] = (current->cells[idx(current, x, y)] && (neighbors == 2 || neighbors == 3)) ||
-                                          (!current->cells[idx(current, x, y)] && neighbors == 3);
+            int neighbors = above[y - 1] + above[y] + above[y + 1] +
+                            row[y - 1]              + row[y + 1] +
+                            below[y - 1] + below[y] + below[y + 1];
+            int alive = row[y];
+            int value = (neighbors == 3) | (alive & (neighbors == 2));
+            out[y] = value;
+            if (tileRow) tileRow[y / DIRTY_TILE_SIZE] |= (value != alive);
         }
     }
 }
 
-bool grids_are_equal(const Grid *g1, const Grid *g2) {
-    return memcmp(g1->cells, g2->cells, g1->rows * g1->cols * sizeof(int)) == 0;
+void next_generation(Grid *current, Grid *next, BoundaryMode boundary, DirtyTiles *dirty) {
+    fill_halo(current, boundary);
+    step_rows_counting(current, next, 0, current->rows, dirty);
 }
 
-void copy_grid(const Grid *src, Grid *dst) {
-    memcpy(dst->cells, src->cells, src->rows * src->cols * sizeof(int));
+// ---------------------------------------------------------
+// Lookup-table kernel: 4x4 neighbourhood -> 2x2 block
+// ---------------------------------------------------------
+
+// Index: four 4-bit rows, top row in the high nibble, leftmost cell in the high bit of each nibble.
+// Entry: the 2x2 center after one step, bits 3..0 = top-left, top-right, bottom-left, bottom-right.
+static uint8_t blockTable[1 << 16];
+
+void init_lut_kernel(void) {
+    static bool built = false;
+    if (built) return;
+    for (int i = 0; i < (1 << 16); i++) {
+        uint8_t block = 0;
+        for (int r = 1; r <= 2; r++) {
+            for (int c = 1; c <= 2; c++) {
+                int neighbors = 0;
+                for (int dr = -1; dr <= 1; dr++) {
+                    for (int dc = -1; dc <= 1; dc++) {
+                        if (dr || dc) neighbors += (i >> (15 - 4 * (r + dr) - (c + dc))) & 1;
+                    }
+                }
+                int alive = (i >> (15 - 4 * r - c)) & 1;
+                int value = (neighbors == 3) | (alive & (neighbors == 2));
+                block |= value << (3 - 2 * (r - 1) - (c - 1));
+            }
+        }
+        blockTable[i] = block;
+    }
+    built = true;
+}
+
+// One cell the 2x2 blocks didn't cover (odd column), the halo of current must be filled
+static inline void step_cell(const Grid *current, Grid *next, int x, int y, DirtyTiles *dirty) {
+    int neighbors = count_neighbors(current, x, y);
+    int alive = current->cells[idx(current, x, y)];
+    int value = (neighbors == 3) | (alive & (neighbors == 2));
+    next->cells[idx(next, x, y)] = value;
+    if (dirty && value != alive) mark_cell_dirty(dirty, x, y);
+}
+
+// Lookup-table blocks over rows [x0, x1) with x0 even, the halo of current must already be filled
+static void step_rows_lut(const Grid *current, Grid *next, int x0, int x1, DirtyTiles *dirty) {
+    int cols = current->cols, stride = current->stride;
+    int x = x0;
+    for (; x + 1 < x1; x += 2) {
+        const int *r0 = &current->cells[idx(current, x - 1, 0)];
+        const int *r1 = r0 + stride, *r2 = r1 + stride, *r3 = r2 + stride;
+        int *out0 = &next->cells[idx(next, x, 0)];
+        int *out1 = out0 + stride;
+        // x is even and DIRTY_TILE_SIZE too, so both rows of a block share a tile
+        unsigned char *tileRow = dirty ? dirty->tiles + (x / DIRTY_TILE_SIZE) * dirty->tileCols : NULL;
+
+        // Each nibble holds columns y-1..y+2 of its row and slides right by two per block
+        unsigned n0 = (r0[-1] << 1) | r0[0], n1 = (r1[-1] << 1) | r1[0];
+        unsigned n2 = (r2[-1] << 1) | r2[0], n3 = (r3[-1] << 1) | r3[0];
+        int y = 0;
+        for (; y + 1 < cols; y += 2) {
+            n0 = ((n0 << 2) | (r0[y + 1] << 1) | r0[y + 2]) & 0xF;
+            n1 = ((n1 << 2) | (r1[y + 1] << 1) | r1[y + 2]) & 0xF;
+            n2 = ((n2 << 2) | (r2[y + 1] << 1) | r2[y + 2]) & 0xF;
+            n3 = ((n3 << 2) | (r3[y + 1] << 1) | r3[y + 2]) & 0xF;
+            unsigned block = blockTable[(n0 << 12) | (n1 << 8) | (n2 << 4) | n3];
+            out0[y]     = (block >> 3) & 1;
+            out0[y + 1] = (block >> 2) & 1;
+            out1[y]     = (block >> 1) & 1;
+            out1[y + 1] = block & 1;
+            // The old 2x2 center sits in bits 2..1 of the two middle nibbles
+            if (tileRow) tileRow[y / DIRTY_TILE_SIZE] |= (block != ((((n1 >> 1) & 3) << 2) | ((n2 >> 1) & 3)));
+        }
+        if (y < cols) { // Odd number of columns
+            step_cell(current, next, x, y, dirty);
+            step_cell(current, next, x + 1, y, dirty);
+        }
+    }
+    if (x < x1) step_rows_counting(current, next, x, x1, dirty); // Odd number of rows
+}
+
+void next_generation_lut(Grid *current, Grid *next, BoundaryMode boundary, DirtyTiles *dirty) {
+    fill_halo(current, boundary);
+    step_rows_lut(current, next, 0, current->rows, dirty);
 }
 
 // ---------------------------------------------------------
-// Pattern Detection
+// Multi-threaded stepping
 // ---------------------------------------------------------
-uint64_t hash_grid(const Grid *g) {
-    uint64_t hash = 1469598103934665603ULL;
-    const uint64_t fnvPrime = 1099511628211ULL;
-    for (int i = 0; i < g->rows * g->cols; i++) {
-        hash ^= (uint64_t)g->cells[i];
-        hash *= fnvPrime;
+
+// Work for one thread: bands first, first + step, first + 2 * step... of tileRows rows each
+typedef struct {
+    const Grid *current;
+    Grid *next;
+    DirtyTiles *dirty;
+    Engine engine;
+    int tileRows;
+    int first;
+    int step;
+} StepJob;
+
+static void step_bands(const StepJob *job) {
+    int rows = job->current->rows;
+    for (int x0 = job->first * job->tileRows; x0 < rows; x0 += job->step * job->tileRows) {
+        int x1 = x0 + job->tileRows < rows ? x0 + job->tileRows : rows;
+        if (job->engine == ENGINE_LUT) step_rows_lut(job->current, job->next, x0, x1, job->dirty);
+        else step_rows_counting(job->current, job->next, x0, x1, job->dirty);
     }
-    return hash;
 }
 
-int detect_pattern(const Grid * const prevStates[], const uint64_t prevHashes[],
-                   const Grid *current, uint64_t curHash, int generation, Options options) {
-    if (generation == 0) return -1;
+// Persistent workers: thread t runs jobs[t] whenever pending[t] is set. They are started the
+// first time step_generation needs them and then sleep between generations.
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t done;                    // Signalled when remaining drops to 0
+    pthread_cond_t wake[MAX_STEP_THREADS];
+    StepJob jobs[MAX_STEP_THREADS];
+    bool pending[MAX_STEP_THREADS];
+    int started;                            // Workers 1..started are running (job 0 is the caller's)
+    int remaining;                          // Jobs of the current generation not finished yet
+} stepPool = { .lock = PTHREAD_MUTEX_INITIALIZER, .done = PTHREAD_COND_INITIALIZER };
 
-    if (curHash == prevHashes[generation - 1] &&
-        grids_are_equal(current, prevStates[generation - 1])) {
-        return 0; // Static pattern
-        }
+static void *pool_worker(void *arg) {
+    int t = (int)(intptr_t)arg;
+    pthread_mutex_lock(&stepPool.lock);
+    for (;;) {
+        while (!stepPool.pending[t]) pthread_cond_wait(&stepPool.wake[t], &stepPool.lock);
+        pthread_mutex_unlock(&stepPool.lock);
+        step_bands(&stepPool.jobs[t]);
+        pthread_mutex_lock(&stepPool.lock);
+        stepPool.pending[t] = false;
+        if (--stepPool.remaining == 0) pthread_cond_signal(&stepPool.done);
+    }
+    return NULL;
+}
 
-    if (options.stopOnLooping) {
-        for (int gen = 0; gen < generation - 1; gen++) {
-            if (curHash == prevHashes[gen] &&
-                grids_are_equal(current, prevStates[gen])) {
-                return 1; // Looping pattern
-                }
+// Start workers until there are `workers` of them. Returns how many are running (fewer if
+// threads couldn't be created).
+static int pool_reserve(int workers) {
+    while (stepPool.started < workers) {
+        int t = stepPool.started + 1;
+        pthread_t thread;
+        pthread_cond_init(&stepPool.wake[t], NULL);
+        if (pthread_create(&thread, NULL, pool_worker, (void *)(intptr_t)t) != 0) {
+            pthread_cond_destroy(&stepPool.wake[t]);
+            break;
         }
+        pthread_detach(thread);
+        stepPool.started = t;
     }
+    return stepPool.started < workers ? stepPool.started : workers;
+}
+
+void step_generation(Grid *current, Grid *next, Options options, DirtyTiles *dirty) {
+    fill_halo(current, options.boundary);
 
-    if (options.stopOnGliding && detect_gliders(current)) {
-        return 2; // Glider detected
+    // Bands are whole rows of dirty tiles, so no two threads flag the same tile (and bands start
+    // on even rows, as the lookup-table kernel needs)
+    int tileRows = options.tileRows < DIRTY_TILE_SIZE ? DIRTY_TILE_SIZE : options.tileRows;
+    tileRows = (tileRows + DIRTY_TILE_SIZE - 1) / DIRTY_TILE_SIZE * DIRTY_TILE_SIZE;
+    int bands = (current->rows + tileRows - 1) / tileRows;
+    int threads = options.threads < 1 ? 1 : options.threads;
+    if (threads > MAX_STEP_THREADS) threads = MAX_STEP_THREADS;
+    if (threads > bands) threads = bands;
+
+    StepJob own = { current, next, dirty, options.engine, tileRows, 0, threads };
+    if (threads == 1) {
+        step_bands(&own);
+        return;
+    }
+
+    int workers = pool_reserve(threads - 1);
+    pthread_mutex_lock(&stepPool.lock);
+    stepPool.remaining = workers;
+    for (int t = 1; t <= workers; t++) {
+        stepPool.jobs[t] = (StepJob){ current, next, dirty, options.engine, tileRows, t, threads };
+        stepPool.pending[t] = true;
+        pthread_cond_signal(&stepPool.wake[t]);
     }
+    pthread_mutex_unlock(&stepPool.lock);
 
-    return -1;
+    step_bands(&own);
+    for (int t = workers + 1; t < threads; t++) { // Couldn't start a worker for these, do their share here
+        StepJob job = { current, next, dirty, options.engine, tileRows, t, threads };
+        step_bands(&job);
+    }
+
+    pthread_mutex_lock(&stepPool.lock);
+    while (stepPool.remaining > 0) pthread_cond_wait(&stepPool.done, &stepPool.lock);
+    pthread_mutex_unlock(&stepPool.lock);
 }
 
-bool detect_gliders(const Grid *grid) {
+bool grids_are_equal(const Grid *g1, const Grid *g2) {
+    for (int x = 0; x < g1->rows; x++) {
+        if (memcmp(&g1->cells[idx(g1, x, 0)], &g2->cells[idx(g2, x, 0)], g1->cols * sizeof(int)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void copy_grid(const Grid *src, Grid *dst) {
+    memcpy(grid_storage(dst), grid_storage(src), (src->rows + 2) * src->stride * sizeof(int));
+}
+
+// ---------------------------------------------------------
+// Pattern Detection
+// ---------------------------------------------------------
+uint64_t hash_grid(const Grid *g) {
+    uint64_t hash = 1469598103934665603ULL;
+    const uint64_t fnvPrime = 1099511628211ULL;
+    for (int x = 0; x < g->rows; x++) {
+        for (int y = 0; y < g->cols; y++) {
+            hash ^= (uint64_t)g->cells[idx(g, x, y)];
+            hash *= fnvPrime;
+        }
+    }
+    return hash;
+}
+
+// Check for a glider whose 3x3 box starts on row x
+static bool glider_in_row(const Grid *grid, int x) {
     static const int gliderPatterns[4][3][3] = {
         {{0, 1, 0}, {0, 0, 1}, {1, 1, 1}},
         {{1, 0, 1}, {1, 0, 0}, {1, 1, 0}},
         {{1, 1, 1}, {1, 0, 0}, {0, 1, 0}},
         {{0, 1, 1}, {1, 1, 0}, {0, 0, 1}}};
 
-    for (int x = 1; x < grid->rows - 3; x++) {
-        for (int y = 1; y < grid->cols - 3; y++) {
-            for (int p = 0; p < 4; p++) {
-                bool match = true;
-                for (int i = -1; i <= 3; i++) {
-                    for (int j = -1; j <= 3; j++) {
-                        if (i >= 0 && i < 3 && j >= 0 && j < 3) {
-                            // Check pattern cells
-                            if (grid->cells[idx(grid, x + i, y + j)] != gliderPatterns[p][i][j]) {
-                                match = false;
-                                break;
-                            }
-                        } else {
-                            // Check surrounding border cells
-                            if (grid->cells[idx(grid, x + i, y + j)] != 0) {
-                                match = false;
-                                break;
-                            }
+    for (int y = 1; y < grid->cols - 3; y++) {
+        for (int p = 0; p < 4; p++) {
+            bool match = true;
+            for (int i = -1; i <= 3; i++) {
+                for (int j = -1; j <= 3; j++) {
+                    if (i >= 0 && i < 3 && j >= 0 && j < 3) {
+                        // Check pattern cells
+                        if (grid->cells[idx(grid, x + i, y + j)] != gliderPatterns[p][i][j]) {
+                            match = false;
+                            break;
+                        }
+                    } else {
+                        // Check surrounding border cells
+                        if (grid->cells[idx(grid, x + i, y + j)] != 0) {
+                            match = false;
+                            break;
                         }
                     }
-                    if (!match) break;
                 }
-                if (match) return true;
+                if (!match) break;
             }
+            if (match) return true;
         }
     }
     return false;
 }
+
+bool detect_gliders(const Grid *grid) {
+    for (int x = 1; x < grid->rows - 3; x++) {
+        if (glider_in_row(grid, x)) return true;
+    }
+    return false;
+}
+
+// ---------------------------------------------------------
+// Time-sliced detection
+// ---------------------------------------------------------
+static double monotonic_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+void detect_job_start(DetectJob *job, int generation) {
+    job->generation = generation;
+    job->phase = DETECT_STATIC;
+    job->cursor = 0;
+    job->result = -1;
+}
+
+static bool detect_job_finish(DetectJob *job, int result) {
+    job->phase = DETECT_DONE;
+    job->result = result;
+    return true;
+}
+
+bool detect_job_run(DetectJob *job, const Grid * const prevStates[], const uint64_t prevHashes[],
+                    Options options, double budgetSeconds) {
+    double deadline = monotonic_seconds() + budgetSeconds;
+    int generation = job->generation;
+    const Grid *current = prevStates[generation];
+    uint64_t curHash = prevHashes[generation];
+
+    while (job->phase != DETECT_DONE) {
+        if (job->phase == DETECT_STATIC) {
+            if (generation == 0) return detect_job_finish(job, -1);
+            if (curHash == prevHashes[generation - 1] &&
+                grids_are_equal(current, prevStates[generation - 1])) {
+                return detect_job_finish(job, 0); // Static pattern
+            }
+            if (options.stopOnLooping) {
+                job->phase = DETECT_LOOP;
+                job->cursor = 0;
+            } else {
+                job->phase = DETECT_GLIDER;
+                job->cursor = 1; // Same first row as detect_gliders, row 0's box would reach into the halo
+            }
+        } else if (job->phase == DETECT_LOOP) {
+            // cursor: next earlier generation to compare against
+            while (job->cursor < generation - 1) {
+                int gen = job->cursor++;
+                if (curHash == prevHashes[gen] && grids_are_equal(current, prevStates[gen])) {
+                    return detect_job_finish(job, 1); // Looping pattern
+                }
+                if ((gen & 255) == 255 && monotonic_seconds() >= deadline) return false;
+            }
+            job->phase = DETECT_GLIDER;
+            job->cursor = 1; // Same first row as detect_gliders
+        } else {
+            // cursor: next row to scan for gliders
+            if (!options.stopOnGliding) return detect_job_finish(job, -1);
+            while (job->cursor < current->rows - 3) {
+                if (glider_in_row(current, job->cursor++)) return detect_job_finish(job, 2); // Glider detected
+                if (monotonic_seconds() >= deadline) return false;
+            }
+            return detect_job_finish(job, -1);
+        }
+    }
+    return true;
+}
@@ -5,20 +5,67 @@
 #include <stdint.h>   // <--- IMPORTANT: for uint64_t
 
 #define MAX_HISTORY 10000
-
-// Options for pattern detection
+#define MAX_STEP_THREADS 64
+
+// How the cells beyond the grid edges are treated
+typedef enum {
+ BOUNDARY_TORUS,   // Edges wrap around to the opposite side
+ BOUNDARY_DEAD,    // Everything outside the grid is dead
+ BOUNDARY_MIRROR,  // Edge cells are reflected outwards
+ BOUNDARY_COUNT
+} BoundaryMode;
+
+// Kernels that can compute the next generation
+typedef enum {
+ ENGINE_AUTO = -1,  // Not an engine: asks autotune to pick one
+ ENGINE_NAIVE,      // Per-cell neighbour counting (next_generation)
+ ENGINE_LUT,        // 2x2 blocks looked up from their 4x4 neighbourhood (next_generation_lut)
+ ENGINE_COUNT
+} Engine;
+
+// Options for pattern detection and stepping
 typedef struct {
  bool stopOnGliding;
  bool stopOnLooping;
+ BoundaryMode boundary;
+ Engine engine;
+ int threads;   // Threads used by step_generation
+ int tileRows;  // Rows per band handed to a thread (rounded up to whole dirty tiles)
 } Options;
 
-// Flattened grid structure
+// Flattened grid structure with a one-cell ghost border (halo) around it.
+// Cell (row, col) lives at cells[row * stride + col]; rows/cols -1 and rows/cols are the halo.
 typedef struct {
  int rows;
  int cols;
- int *cells;  // Single, contiguous array of size rows*cols
+ int stride;  // Cells per stored row (cols + 2)
+ int *cells;  // Points at cell (0, 0) inside a contiguous (rows + 2) * stride array
 } Grid;
 
+// Stages of a DetectJob, in the order its checks run
+typedef enum {
+ DETECT_STATIC,
+ DETECT_LOOP,
+ DETECT_GLIDER,
+ DETECT_DONE
+} DetectPhase;
+
+// Pattern detection on a recorded generation, split so it can resume across frames
+typedef struct {
+ int generation;     // History index being examined
+ DetectPhase phase;
+ int cursor;         // Resume point: earlier generation (DETECT_LOOP) or grid row (DETECT_GLIDER)
+ int result;         // Final once phase == DETECT_DONE, see detect_job_run
+} DetectJob;
+
+#define DIRTY_TILE_SIZE 16
+
+// Per-tile change flags: set by next_generation/editing, cleared by the renderer
+typedef struct {
+ int tileRows;
+ int tileCols;
+ unsigned char *tiles;  // tileRows*tileCols flags, non-zero if any cell in the tile changed
+} DirtyTiles;
 
 /**
  * Create a new grid with the given dimensions (rows x cols).
@@ -29,6 +76,27 @@ void destroy_grid(Grid *grid);
 
 
 
+/**
+ * Create the dirty-tile map covering a rows x cols grid (all tiles start dirty).
+ */
+DirtyTiles *create_dirty_tiles(int rows, int cols);
+void destroy_dirty_tiles(DirtyTiles *dirty);
+
+/**
+ * Flag every tile as changed (after clear/randomize/resize).
+ */
+void mark_all_dirty(DirtyTiles *dirty);
+
+/**
+ * Flag the tile containing cell (row, col) as changed.
+ */
+void mark_cell_dirty(DirtyTiles *dirty, int row, int col);
+
+/**
+ * Check if any tile is flagged as changed.
+ */
+bool any_tile_dirty(const DirtyTiles *dirty);
+
 /**
  * Create a history (an array) of Grid pointers for up to maxHistory generations.
  */
@@ -56,14 +124,40 @@ void randomize_grid(Grid *grid);
 void copy_grid(const Grid *src, Grid *dst);
 
 /**
- * Count the number of alive neighbors (with wrapping).
+ * Refill the halo around the grid according to the boundary mode.
+ */
+void fill_halo(Grid *grid, BoundaryMode boundary);
+
+/**
+ * Count the number of alive neighbors (reads the halo, so it must be filled).
  */
 int count_neighbors(const Grid *grid, int x, int y);
 
 /**
  * Compute the next generation of cells from current -> next.
+ * The halo of current is refilled first using the given boundary mode.
+ * If dirty is not NULL, the tiles containing cells that changed are flagged in it.
+ */
+void next_generation(Grid *current, Grid *next, BoundaryMode boundary, DirtyTiles *dirty);
+
+/**
+ * Build the 65536-entry table used by next_generation_lut. Call once at startup.
+ */
+void init_lut_kernel(void);
+
+/**
+ * Same result as next_generation, but each 2x2 block of cells is looked up from a table
+ * indexed by its surrounding 4x4 neighbourhood. Requires init_lut_kernel.
+ */
+void next_generation_lut(Grid *current, Grid *next, BoundaryMode boundary, DirtyTiles *dirty);
+
+/**
+ * Compute the next generation with the engine, boundary mode, thread count and band size
+ * selected in options. Same result as next_generation.
+ * Worker threads are started on first use and reused for later generations, so only one
+ * thread at a time may call this.
  */
-void next_generation(const Grid *current, Grid *next);
+void step_generation(Grid *current, Grid *next, Options options, DirtyTiles *dirty);
 
 /**
  * Check if two grids have identical cell data.
@@ -71,16 +165,21 @@ void next_generation(const Grid *current, Grid *next);
 bool grids_are_equal(const Grid *g1, const Grid *g2);
 
 /**
- * Detect patterns:
- *  - Returns  0 if the grid is the same as the immediate previous generation (static).
- *  - Returns  1 if the grid matches *any* earlier generation (looping).
- *  - Returns  2 if a glider is detected (only if stopOnGliding = true).
- *  - Returns -1 if no pattern found.
+ * Start detecting patterns on prevStates[generation] (the grid recorded for that generation).
  */
-int detect_pattern(const Grid * const prevStates[], const uint64_t prevHashes[],
-                   const Grid *current, uint64_t curHash, int generation, Options options);
-
+void detect_job_start(DetectJob *job, int generation);
 
+/**
+ * Continue a detection job for at most about budgetSeconds.
+ * Returns true once job->result is final, false if it ran out of time
+ * (call again, e.g. next frame, to resume where it stopped). The result:
+ *  -  0 if the grid is the same as the immediate previous generation (static).
+ *  -  1 if the grid matches *any* earlier generation (looping, only if stopOnLooping = true).
+ *  -  2 if a glider is detected (only if stopOnGliding = true).
+ *  - -1 if no pattern found.
+ */
+bool detect_job_run(DetectJob *job, const Grid * const prevStates[], const uint64_t prevHashes[],
+                    Options options, double budgetSeconds);
 
 /**
  * Detect if a glider is present in the grid.
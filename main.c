@@ -1,13 +1,23 @@
 #include <raylib.h>
+#include <errno.h>
+#include <limits.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#include <string.h>
+#include <time.h>
 
+#include "census.h"
 #include "game.h"
+#include "ooc.h"
+#include "stream.h"
+#include "tune.h"
 #include "ui.h"
 
+#define DETECT_FRAME_BUDGET 0.004 // Seconds of pattern detection per frame (60 FPS leaves ~16 ms)
+
 typedef enum {
     STATE_MENU,
     STATE_SIMULATION
@@ -17,6 +27,7 @@ typedef struct {
     AppState state;
     Grid *current;
     Grid *next;
+    DirtyTiles *dirty;
     Grid *historyStates[MAX_HISTORY];
     uint64_t historyHashes[MAX_HISTORY];
     Options options;
@@ -27,21 +38,72 @@ typedef struct {
     float accumulator;
     float stepTime;
     int cellSize;
+    DetectJob detectJob;  // Detection in progress, resumed every frame
+    int detectedUpTo;     // Last generation whose detection has finished
+    int detection;        // Detection result the simulation stopped on, -1 while none
+    StreamServer *server; // NULL unless started with --serve
+    Census *census;       // Objects left on the board, filled when the simulation stops
 } GameState;
 
 void handle_menu(GameState *gameState);
 void handle_simulation(GameState *gameState);
+void record_history(GameState *gameState);
+void run_detection(GameState *gameState);
 void draw_menu(const GameState *gameState);
 void draw_simulation(const GameState *gameState);
+int run_out_of_core(const char *path, int rows, int cols, bool resolutionProvided, int generations);
+bool parse_number(const char *text, int min, int *value);
+int usage(const char *program);
 
 int main(int argc, char *argv[]) {
     int rows = 10, cols = 10;
-    if (argc == 3) { // Check if there were args of rows and cols then use them
-        rows = atoi(argv[1]);
-        cols = atoi(argv[2]);
+    int dims[2];
+    int dimCount = 0;
+    const char *servePath = NULL;
+    const char *oocPath = NULL;
+    int generations = 1;
+    // Manual overrides of the autotuned stepping configuration
+    Engine engine = ENGINE_AUTO;
+    int threads = TUNE_FREE, tileRows = TUNE_FREE;
+    bool retune = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--serve") == 0) { // Stream generations to viewers on the default socket
+            servePath = STREAM_DEFAULT_PATH;
+        } else if (strncmp(argv[i], "--serve=", 8) == 0) {
+            servePath = argv[i] + 8;
+        } else if (strncmp(argv[i], "--ooc=", 6) == 0) { // Headless: step a board file too big for RAM
+            oocPath = argv[i] + 6;
+        } else if (strncmp(argv[i], "--generations=", 14) == 0) {
+            if (!parse_number(argv[i] + 14, 0, &generations)) return usage(argv[0]);
+        } else if (strcmp(argv[i], "--engine=naive") == 0) {
+            engine = ENGINE_NAIVE;
+        } else if (strcmp(argv[i], "--engine=lut") == 0) {
+            engine = ENGINE_LUT;
+        } else if (strncmp(argv[i], "--threads=", 10) == 0) {
+            if (!parse_number(argv[i] + 10, 1, &threads)) return usage(argv[0]);
+        } else if (strncmp(argv[i], "--tile=", 7) == 0) {
+            if (!parse_number(argv[i] + 7, 1, &tileRows)) return usage(argv[0]);
+        } else if (strcmp(argv[i], "--retune") == 0) {
+            retune = true;
+        } else if (dimCount == 2 || !parse_number(argv[i], 1, &dims[dimCount])) {
+            return usage(argv[0]); // Unknown option, bad value or a third number
+        } else {
+            dimCount++;
+        }
+    }
+    if (dimCount == 1) return usage(argv[0]);
+    if (dimCount == 2) { // Check if there were args of rows and cols then use them
+        rows = dims[0];
+        cols = dims[1];
     }
+    if (oocPath) return run_out_of_core(oocPath, rows, cols, dimCount == 2, generations);
     //if there weren't args, then ask for input with selection screen
-    if (!select_resolution_if_needed(&rows, &cols, argc == 3)) return 0;
+    if (!select_resolution_if_needed(&rows, &cols, dimCount == 2)) return 0;
+
+    // Overridden settings stay fixed, autotune only searches the rest
+    Options options = { .stopOnGliding = false, .stopOnLooping = true, .boundary = BOUNDARY_TORUS,
+                        .engine = engine, .threads = threads, .tileRows = tileRows };
+    autotune(rows, cols, &options, retune);
 
     //Remove window header and resizing
     SetConfigFlags(FLAG_WINDOW_RESIZABLE | FLAG_WINDOW_UNDECORATED);
@@ -49,21 +111,32 @@ int main(int argc, char *argv[]) {
     SetTargetFPS(60);
 
     show_splash_screen();
+    init_lut_kernel();
 
     GameState gameState = {
         .state = STATE_MENU,
         .current = create_grid(rows, cols),
         .next = create_grid(rows, cols),
-        .options = { .stopOnGliding = false, .stopOnLooping = true },
+        .dirty = create_dirty_tiles(rows, cols),
+        .options = options,
         .paused = false,
         .running = true,
         .generation = 0,
         .simulationSpeed = 1.0f,
         .accumulator = 0.0f,
         .stepTime = 0.05f,
-        .cellSize = calculate_cell_size(rows, cols)
+        .cellSize = calculate_cell_size(rows, cols),
+        .detectedUpTo = 0,
+        .detection = -1,
+        .server = NULL,
+        .census = create_census()
     };
 
+    if (servePath) {
+        gameState.server = stream_server_create(servePath, rows, cols);
+        if (!gameState.server) fprintf(stderr, "Could not listen on %s, streaming disabled\n", servePath);
+    }
+
     for (int i = 0; i < MAX_HISTORY; i++) { //Fill historyStates with empty grids
         gameState.historyStates[i] = create_grid(rows, cols);
         gameState.historyHashes[i] = 0;
@@ -71,6 +144,8 @@ int main(int argc, char *argv[]) {
     clear_grid(gameState.current); //Clear the grid
 
     while (!WindowShouldClose()) {
+        if (gameState.server) stream_server_poll(gameState.server);
+
         if (gameState.state == STATE_MENU) {
             handle_menu(&gameState);
         } else if (gameState.state == STATE_SIMULATION) {
@@ -90,6 +165,9 @@ int main(int argc, char *argv[]) {
 
     destroy_grid(gameState.current);
     destroy_grid(gameState.next);
+    destroy_dirty_tiles(gameState.dirty);
+    stream_server_destroy(gameState.server);
+    destroy_census(gameState.census);
     for (int i = 0; i < MAX_HISTORY; i++) {
         destroy_grid(gameState.historyStates[i]);
     }
@@ -98,11 +176,64 @@ int main(int argc, char *argv[]) {
 }
 
 void handle_menu(GameState *gameState) {
-    if (handle_menu_input(gameState->current, &gameState->options, &gameState->cellSize)) {
+    bool start = handle_menu_input(gameState->current, &gameState->options, &gameState->cellSize, gameState->dirty);
+    // Stream editor changes too (the dirty tiles are cleared once the grid is drawn)
+    if (gameState->server && !start && any_tile_dirty(gameState->dirty)) {
+        stream_server_publish(gameState->server, gameState->current, 0);
+    }
+    if (start) {
         gameState->state = STATE_SIMULATION;
         gameState->generation = 0;
         gameState->paused = false;
         gameState->running = true;
+        gameState->detectedUpTo = 0;
+        gameState->detection = -1;
+        detect_job_start(&gameState->detectJob, 0);
+        gameState->detectJob.phase = DETECT_DONE; // Nothing to compare generation 0 against
+        record_history(gameState);
+        if (gameState->server) stream_server_publish(gameState->server, gameState->current, 0);
+    }
+}
+
+void record_history(GameState *gameState) {
+    if (gameState->generation < MAX_HISTORY) {
+        copy_grid(gameState->current, gameState->historyStates[gameState->generation]);
+        gameState->historyHashes[gameState->generation] = hash_grid(gameState->current);
+    }
+}
+
+// Advance pattern detection over the recorded generations within this frame's budget.
+// The simulation may run ahead meanwhile; a hit rolls it back to the generation it was found on.
+void run_detection(GameState *gameState) {
+    double deadline = GetTime() + DETECT_FRAME_BUDGET;
+    int last = gameState->generation < MAX_HISTORY ? gameState->generation : MAX_HISTORY - 1;
+    DetectJob *job = &gameState->detectJob;
+
+    while (gameState->running) {
+        if (job->phase == DETECT_DONE) {
+            if (gameState->detectedUpTo >= last) return;
+            detect_job_start(job, gameState->detectedUpTo + 1);
+        }
+        double remaining = deadline - GetTime();
+        if (remaining <= 0 || !detect_job_run(job, (const Grid * const *)gameState->historyStates,
+                                              gameState->historyHashes, gameState->options, remaining)) {
+            return;
+        }
+        gameState->detectedUpTo = job->generation;
+        if (job->result == -1) continue;
+
+        // Stop on the generation where the pattern appeared
+        gameState->running = false;
+        gameState->paused = true;
+        gameState->detection = job->result;
+        if (job->generation != gameState->generation) {
+            copy_grid(gameState->historyStates[job->generation], gameState->current);
+            gameState->generation = job->generation;
+            mark_all_dirty(gameState->dirty);
+            if (gameState->server) stream_server_publish(gameState->server, gameState->current, gameState->generation);
+        }
+        census_clear(gameState->census);
+        census_run(gameState->census, gameState->current, gameState->options.boundary);
     }
 }
 
@@ -112,10 +243,12 @@ void handle_simulation(GameState *gameState) {
     if (IsKeyPressed(KEY_DOWN)) gameState->simulationSpeed = fmaxf(gameState->simulationSpeed / 2.0f, 0.125f);
     if (IsKeyPressed(KEY_R)) {
         clear_grid(gameState->current);
+        mark_all_dirty(gameState->dirty);
         gameState->generation = 0;
         gameState->state = STATE_MENU;
         gameState->paused = false;
         gameState->running = true;
+        if (gameState->server) stream_server_publish(gameState->server, gameState->current, 0);
         return;
     }
 
@@ -125,60 +258,101 @@ void handle_simulation(GameState *gameState) {
         while (gameState->accumulator >= gameState->stepTime) {
             gameState->accumulator -= gameState->stepTime;
 
-            if (gameState->generation < MAX_HISTORY) {
-                copy_grid(gameState->current, gameState->historyStates[gameState->generation]);
-                gameState->historyHashes[gameState->generation] = hash_grid(gameState->current);
-            }
-
-            if (gameState->generation > 0 && gameState->generation < MAX_HISTORY) {
-                int detection = detect_pattern(
-                    (const Grid * const *)gameState->historyStates,
-                    gameState->historyHashes,
-                    gameState->current,
-                    hash_grid(gameState->current),
-                    gameState->generation,
-                    gameState->options
-                );
-                if (detection != -1) {
-                    gameState->running = false;
-                    gameState->paused = true;
-                    break;
-                }
-            }
-
-
-            next_generation(gameState->current, gameState->next);
+            step_generation(gameState->current, gameState->next, gameState->options, gameState->dirty);
             Grid *temp = gameState->current;
             gameState->current = gameState->next;
             gameState->next = temp;
             gameState->generation++;
+            record_history(gameState);
+            if (gameState->server) stream_server_publish(gameState->server, gameState->current, gameState->generation);
         }
     }
+    run_detection(gameState);
 }
 
 void draw_menu(const GameState *gameState) {
-    draw_menu_ui(gameState->current, gameState->options, gameState->cellSize);
+    draw_menu_ui(gameState->current, gameState->options, gameState->cellSize, gameState->dirty);
 }
 
 void draw_simulation(const GameState *gameState) {
-    int detection = -1;
-    if (gameState->generation > 0 && gameState->generation < MAX_HISTORY) {
-        detection = detect_pattern(
-            (const Grid * const *)gameState->historyStates, //Cast to const pointer necessary for the compiler ?¿
-            gameState->historyHashes,
-            gameState->current,
-            hash_grid(gameState->current),
-            gameState->generation,
-            gameState->options
-        );
-    }
     draw_simulation_ui(
         gameState->current,
         gameState->generation,
         gameState->paused,
         gameState->running,
         gameState->simulationSpeed,
-        detection,
-        gameState->cellSize
+        gameState->detection,
+        gameState->cellSize,
+        gameState->dirty,
+        gameState->running ? NULL : gameState->census
     );
 }
+
+int run_out_of_core(const char *path, int rows, int cols, bool resolutionProvided, int generations) {
+    OocBoard *board = ooc_open(path);
+    if (!board && errno != ENOENT) { // Never overwrite a file that isn't a board
+        fprintf(stderr, "%s exists but is not a board file\n", path);
+        return 1;
+    }
+    if (!board) { // New board, needs its size from the command line
+        if (!resolutionProvided || !(board = ooc_create(path, rows, cols))) {
+            fprintf(stderr, "Could not create %s (pass rows and cols to create a new board)\n", path);
+            return 1;
+        }
+        ooc_randomize(board, (uint64_t)time(NULL));
+    }
+
+    // Generations ping-pong between the board file and a scratch file next to it. A scratch
+    // board of the same size left by an interrupted run is reused, anything else is left alone.
+    char nextPath[4096];
+    snprintf(nextPath, sizeof(nextPath), "%s.next", path);
+    OocBoard *next = ooc_open(nextPath);
+    if (!next && errno == ENOENT) next = ooc_create(nextPath, board->rows, board->cols);
+    if (!next || next->rows != board->rows || next->cols != board->cols) {
+        fprintf(stderr, "Could not use %s as scratch board (move it out of the way)\n", nextPath);
+        ooc_close(next);
+        ooc_close(board);
+        return 1;
+    }
+
+    bool resultInNext = false;
+    for (int i = 0; i < generations; i++) {
+        ooc_step(board, next, 0);
+        OocBoard *temp = board;
+        board = next;
+        next = temp;
+        resultInNext = !resultInNext;
+        printf("Generation %lld\n", (long long)board->generation);
+    }
+
+    ooc_close(board);
+    ooc_close(next);
+    if (resultInNext) rename(nextPath, path);
+    else remove(nextPath);
+    return 0;
+}
+
+// Whole-string decimal number of at least `min`
+bool parse_number(const char *text, int min, int *value) {
+    char *end;
+    errno = 0;
+    long number = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || number < min || number > INT_MAX) return false;
+    *value = (int)number;
+    return true;
+}
+
+int usage(const char *program) {
+    fprintf(stderr,
+            "Usage: %s [ROWS COLS] [options]\n"
+            "  --serve[=PATH]          Stream generations to viewers (default %s)\n"
+            "  --ooc=FILE              Step a board file too big for RAM instead of opening the window\n"
+            "  --generations=N         Generations to step with --ooc (default 1)\n"
+            "  --engine=naive|lut      Stepping engine\n"
+            "  --threads=N             Stepping threads\n"
+            "  --tile=N                Rows per band handed to a thread\n"
+            "  --retune                Ignore the cached tuning profile\n"
+            "ROWS and COLS must both be given, and at least 1.\n",
+            program, STREAM_DEFAULT_PATH);
+    return 1;
+}
@@ -0,0 +1,198 @@
+// Out-of-core stepping: bit-packed boards in memory-mapped files, streamed in row bands
+#define _GNU_SOURCE // sync_file_range
+#include "ooc.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define OOC_MAGIC 0x434F4F59574E4B31ull
+
+// On-disk header at offset 0
+typedef struct {
+    uint64_t magic;
+    int64_t rows;
+    int64_t cols;
+    int64_t generation;
+} OocHeader;
+
+static OocBoard *map_board(int fd, int64_t rows, int64_t cols, int64_t generation) {
+    OocBoard *b = calloc(1, sizeof(OocBoard));
+    b->fd = fd;
+    b->rows = rows;
+    b->cols = cols;
+    b->generation = generation;
+    b->wordsPerRow = (cols + 63) / 64;
+    b->mapSize = OOC_DATA_OFFSET + (size_t)rows * b->wordsPerRow * sizeof(uint64_t);
+    b->map = mmap(NULL, b->mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (b->map == MAP_FAILED) {
+        close(fd);
+        free(b);
+        return NULL;
+    }
+    b->words = (uint64_t *)(b->map + OOC_DATA_OFFSET);
+    madvise(b->map, b->mapSize, MADV_SEQUENTIAL);
+    return b;
+}
+
+OocBoard *ooc_create(const char *path, int64_t rows, int64_t cols) {
+    if (rows < 1 || cols < 1) return NULL;
+    int fd = open(path, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd == -1) return NULL;
+    OocHeader header = { .magic = OOC_MAGIC, .rows = rows, .cols = cols, .generation = 0 };
+    size_t size = OOC_DATA_OFFSET + (size_t)rows * ((cols + 63) / 64) * sizeof(uint64_t);
+    if (ftruncate(fd, size) == -1 || pwrite(fd, &header, sizeof(header), 0) != sizeof(header)) {
+        close(fd);
+        return NULL;
+    }
+    return map_board(fd, rows, cols, 0);
+}
+
+OocBoard *ooc_open(const char *path) {
+    int fd = open(path, O_RDWR);
+    if (fd == -1) return NULL;
+    OocHeader header;
+    struct stat st;
+    if (pread(fd, &header, sizeof(header), 0) != sizeof(header) || header.magic != OOC_MAGIC ||
+        header.rows < 1 || header.cols < 1 || fstat(fd, &st) == -1 ||
+        st.st_size < OOC_DATA_OFFSET + header.rows * ((header.cols + 63) / 64) * (int64_t)sizeof(uint64_t)) {
+        close(fd);
+        errno = EINVAL;
+        return NULL;
+    }
+    return map_board(fd, header.rows, header.cols, header.generation);
+}
+
+void ooc_close(OocBoard *board) {
+    if (!board) return;
+    OocHeader header = { .magic = OOC_MAGIC, .rows = board->rows, .cols = board->cols, .generation = board->generation };
+    memcpy(board->map, &header, sizeof(header));
+    munmap(board->map, board->mapSize);
+    close(board->fd);
+    free(board);
+}
+
+static inline uint64_t *row_words(const OocBoard *b, int64_t row) {
+    return b->words + row * b->wordsPerRow;
+}
+
+// Mask of the valid bits in the last word of a row
+static inline uint64_t last_word_mask(const OocBoard *b) {
+    int used = (int)(b->cols - (b->wordsPerRow - 1) * 64);
+    return used == 64 ? ~0ull : (1ull << used) - 1;
+}
+
+void ooc_randomize(OocBoard *board, uint64_t seed) {
+    uint64_t state = seed ? seed : 0x9E3779B97F4A7C15ull;
+    uint64_t mask = last_word_mask(board);
+    for (int64_t r = 0; r < board->rows; r++) {
+        uint64_t *row = row_words(board, r);
+        for (int64_t k = 0; k < board->wordsPerRow; k++) {
+            state ^= state << 13; // xorshift64
+            state ^= state >> 7;
+            state ^= state << 17;
+            row[k] = state;
+        }
+        row[board->wordsPerRow - 1] &= mask;
+    }
+}
+
+// ---------------------------------------------------------
+// Bit-parallel row kernel
+// ---------------------------------------------------------
+
+// Word k of a row shifted so bit j holds the west (col - 1) / east (col + 1) neighbour, wrapping
+static inline void row_neighbours(const uint64_t *row, int64_t k, int64_t words, int lastBit,
+                                  uint64_t *west, uint64_t *east) {
+    uint64_t x = row[k];
+    uint64_t inWest = k > 0 ? row[k - 1] >> 63 : (row[words - 1] >> lastBit) & 1;
+    uint64_t inEast = k < words - 1 ? row[k + 1] << 63 : (row[0] & 1) << lastBit;
+    *west = (x << 1) | inWest;
+    *east = (x >> 1) | inEast;
+}
+
+// One output row from the rows above, at and below it, 64 cells per word
+static void step_row(const uint64_t *above, const uint64_t *row, const uint64_t *below,
+                     uint64_t *out, int64_t words, int lastBit, uint64_t lastMask) {
+    for (int64_t k = 0; k < words; k++) {
+        uint64_t aw, ae, rw, re, bw, be;
+        row_neighbours(above, k, words, lastBit, &aw, &ae);
+        row_neighbours(row, k, words, lastBit, &rw, &re);
+        row_neighbours(below, k, words, lastBit, &bw, &be);
+        uint64_t a = above[k], x = row[k], b = below[k];
+
+        // Sum the 8 neighbours with full adders: rows above/below give 0..3, the middle 0..2
+        uint64_t sa = aw ^ a ^ ae, ca = (aw & a) | (ae & (aw ^ a));
+        uint64_t sb = bw ^ b ^ be, cb = (bw & b) | (be & (bw ^ b));
+        uint64_t sm = rw ^ re, cm = rw & re;
+        uint64_t ones = sa ^ sb ^ sm, carry = (sa & sb) | (sm & (sa ^ sb));
+        // Exactly one of the four "twos" set means the total is 2 (ones == 0) or 3 (ones == 1)
+        uint64_t t1 = ca ^ cb, t2 = cm ^ carry;
+        uint64_t oneTwo = (t1 ^ t2) & ~((ca & cb) | (cm & carry) | (t1 & t2));
+        out[k] = oneTwo & (ones | x);
+    }
+    out[words - 1] &= lastMask;
+}
+
+// ---------------------------------------------------------
+// Band pipeline
+// ---------------------------------------------------------
+
+// Page-aligned madvise over rows [first, last) of a board
+static void advise_rows(const OocBoard *b, int64_t first, int64_t last, int advice) {
+    if (first < 0) first = 0;
+    if (last > b->rows) last = b->rows;
+    if (first >= last) return;
+    uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)row_words(b, first) & ~(page - 1);
+    uintptr_t end = (uintptr_t)row_words(b, last);
+    madvise((void *)start, end - start, advice);
+}
+
+// Start writing rows [first, last) of a board back to disk without waiting for it
+static void write_behind(const OocBoard *b, int64_t first, int64_t last) {
+    if (first < 0) first = 0;
+    if (last > b->rows) last = b->rows;
+    if (first >= last) return;
+    off_t start = OOC_DATA_OFFSET + first * b->wordsPerRow * (off_t)sizeof(uint64_t);
+    off_t length = (last - first) * b->wordsPerRow * (off_t)sizeof(uint64_t);
+    sync_file_range(b->fd, start, length, SYNC_FILE_RANGE_WRITE);
+}
+
+bool ooc_step(const OocBoard *src, OocBoard *dst, int64_t bandRows) {
+    if (src->rows != dst->rows || src->cols != dst->cols) return false;
+    int64_t rows = src->rows, words = src->wordsPerRow;
+    int lastBit = (int)((src->cols - 1) % 64);
+    uint64_t lastMask = last_word_mask(src);
+    if (bandRows <= 0) bandRows = OOC_BAND_BYTES / (words * (int64_t)sizeof(uint64_t));
+    if (bandRows < 1) bandRows = 1;
+
+    // The first band also needs the last row (wrap) and the band after it
+    advise_rows(src, rows - 1, rows, MADV_WILLNEED);
+    advise_rows(src, 0, 2 * bandRows, MADV_WILLNEED);
+
+    for (int64_t first = 0; first < rows; first += bandRows) {
+        int64_t last = first + bandRows < rows ? first + bandRows : rows;
+
+        // Read ahead the band after this one while this one is computed
+        advise_rows(src, last, last + bandRows, MADV_WILLNEED);
+
+        for (int64_t r = first; r < last; r++) {
+            const uint64_t *above = row_words(src, r == 0 ? rows - 1 : r - 1);
+            const uint64_t *below = row_words(src, r == rows - 1 ? 0 : r + 1);
+            step_row(above, row_words(src, r), below, row_words(dst, r), words, lastBit, lastMask);
+        }
+
+        // This band is done: write it behind, and let go of the previous one. The next band
+        // still needs this band's last input row, so only rows before it are dropped.
+        write_behind(dst, first, last);
+        advise_rows(src, first - bandRows, first - 1, MADV_DONTNEED);
+        advise_rows(dst, first - bandRows, first, MADV_DONTNEED);
+    }
+
+    dst->generation = src->generation + 1;
+    return true;
+}
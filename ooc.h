@@ -0,0 +1,50 @@
+#ifndef OOC_H
+#define OOC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define OOC_DATA_OFFSET 4096          // Cells start one page into the file, after the header
+#define OOC_BAND_BYTES (64ll << 20)   // Target size of one row band in memory
+
+// Out-of-core board: a bit-packed torus kept in a memory-mapped file.
+// Row r is wordsPerRow uint64 words, column c is bit (c % 64) of word (c / 64); padding bits stay 0.
+typedef struct {
+ int fd;
+ int64_t rows;
+ int64_t cols;
+ int64_t wordsPerRow;
+ int64_t generation;
+ unsigned char *map;  // Whole file mapping (header + cells)
+ size_t mapSize;
+ uint64_t *words;     // First word of row 0
+} OocBoard;
+
+/**
+ * Create a new board file of rows x cols dead cells. The file is sparse until written.
+ * Never touches an existing file: returns NULL (errno EEXIST) if path already exists.
+ */
+OocBoard *ooc_create(const char *path, int64_t rows, int64_t cols);
+
+/**
+ * Open an existing board file. Returns NULL if it is missing (errno ENOENT) or not a
+ * board file (errno EINVAL).
+ */
+OocBoard *ooc_open(const char *path);
+void ooc_close(OocBoard *board);
+
+/**
+ * Fill the board with random cells (about half alive).
+ */
+void ooc_randomize(OocBoard *board, uint64_t seed);
+
+/**
+ * Write the next generation of src into dst (same dimensions, wrapping like BOUNDARY_TORUS).
+ * Rows are streamed in bands of bandRows (0 picks one from OOC_BAND_BYTES): only the band being
+ * computed and its neighbours are kept resident, the next band is read ahead and finished
+ * output bands are written back while the following ones are computed.
+ */
+bool ooc_step(const OocBoard *src, OocBoard *dst, int64_t bandRows);
+
+#endif // OOC_H
@@ -0,0 +1,384 @@
+// Local grid streaming: a non-blocking Unix socket server and the matching reader
+#define _POSIX_C_SOURCE 200809L
+#include "stream.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------
+// Frames
+// ---------------------------------------------------------
+
+// Reference-counted encoded frame. Frames are shared by every viewer that needs the same bytes,
+// and are sent straight from here, so there's no per-viewer copy.
+typedef struct {
+    int refs;
+    size_t size;          // Header + payload
+    unsigned char data[]; // StreamHeader followed by the payload
+} StreamFrame;
+
+static StreamFrame *frame_create(StreamFrameType type, int rows, int cols, int generation, size_t payloadSize) {
+    StreamFrame *f = malloc(sizeof(StreamFrame) + sizeof(StreamHeader) + payloadSize);
+    f->refs = 1;
+    f->size = sizeof(StreamHeader) + payloadSize;
+    StreamHeader header = {
+        .magic = STREAM_MAGIC,
+        .type = type,
+        .rows = rows,
+        .cols = cols,
+        .generation = generation,
+        .payloadSize = (uint32_t)payloadSize
+    };
+    memcpy(f->data, &header, sizeof(header));
+    return f;
+}
+
+static StreamFrame *frame_ref(StreamFrame *f) {
+    f->refs++;
+    return f;
+}
+
+static void frame_unref(StreamFrame *f) {
+    if (f && --f->refs == 0) free(f);
+}
+
+static void pack_grid(const Grid *g, uint64_t *words, int wordCount) {
+    memset(words, 0, wordCount * sizeof(uint64_t));
+    long bit = 0;
+    for (int x = 0; x < g->rows; x++) {
+        for (int y = 0; y < g->cols; y++, bit++) {
+            words[bit >> 6] |= (uint64_t)(g->cells[x * g->stride + y] != 0) << (bit & 63);
+        }
+    }
+}
+
+static StreamFrame *encode_snapshot(const uint64_t *words, int wordCount, int rows, int cols, int generation) {
+    StreamFrame *f = frame_create(STREAM_FRAME_SNAPSHOT, rows, cols, generation, wordCount * sizeof(uint64_t));
+    memcpy(f->data + sizeof(StreamHeader), words, wordCount * sizeof(uint64_t));
+    return f;
+}
+
+// Encode the words that differ between `from` and `to` as runs of XOR words
+static StreamFrame *encode_delta(const uint64_t *from, const uint64_t *to, int wordCount,
+                                 int rows, int cols, int generation) {
+    // First pass sizes the payload so the frame is allocated once
+    size_t payloadSize = 0;
+    for (int i = 0; i < wordCount; ) {
+        if (from[i] == to[i]) { i++; continue; }
+        payloadSize += 2 * sizeof(uint32_t);
+        while (i < wordCount && from[i] != to[i]) {
+            payloadSize += sizeof(uint64_t);
+            i++;
+        }
+    }
+
+    StreamFrame *f = frame_create(STREAM_FRAME_DELTA, rows, cols, generation, payloadSize);
+    unsigned char *out = f->data + sizeof(StreamHeader);
+    int runEnd = 0;
+    for (int i = 0; i < wordCount; ) {
+        if (from[i] == to[i]) { i++; continue; }
+        int start = i;
+        while (i < wordCount && from[i] != to[i]) i++;
+        uint32_t run[2] = { (uint32_t)(start - runEnd), (uint32_t)(i - start) };
+        memcpy(out, run, sizeof(run));
+        out += sizeof(run);
+        for (int w = start; w < i; w++) {
+            uint64_t diff = from[w] ^ to[w];
+            memcpy(out, &diff, sizeof(diff));
+            out += sizeof(diff);
+        }
+        runEnd = i;
+    }
+    return f;
+}
+
+// ---------------------------------------------------------
+// Server
+// ---------------------------------------------------------
+typedef struct {
+    int fd;
+    StreamFrame *pending; // Frame being sent, NULL when idle
+    size_t sent;          // Bytes of pending already written
+    long seq;             // Publish sequence the viewer reaches once pending is sent, -1 before the snapshot
+    bool lagging;         // Missed at least one publish while busy
+    uint64_t *baseline;   // Packed grid at `seq`, only maintained while lagging
+} StreamClient;
+
+struct StreamServer {
+    int listenFd;
+    char path[sizeof(((struct sockaddr_un *)0)->sun_path)];
+    int rows;
+    int cols;
+    int wordCount;
+    uint64_t *packed;      // Latest published grid
+    uint64_t *previous;    // Grid published before it
+    long seq;              // Number of publishes so far
+    int generation;
+    StreamFrame *delta;    // Shared previous -> packed delta, built on first use
+    StreamFrame *snapshot; // Shared snapshot of packed, built on first use
+    StreamClient clients[STREAM_MAX_CLIENTS];
+    int clientCount;
+};
+
+static bool set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags != -1 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) != -1;
+}
+
+StreamServer *stream_server_create(const char *path, int rows, int cols) {
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+    if (strlen(path) >= sizeof(addr.sun_path)) return NULL;
+    strcpy(addr.sun_path, path);
+
+    // A stale socket from a previous run is replaced, any other file at path is left alone
+    struct stat st;
+    if (lstat(path, &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) return NULL;
+        unlink(path);
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1) return NULL;
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) == -1 ||
+        listen(fd, STREAM_MAX_CLIENTS) == -1 || !set_nonblocking(fd)) {
+        close(fd);
+        return NULL;
+    }
+
+    StreamServer *s = calloc(1, sizeof(StreamServer));
+    s->listenFd = fd;
+    strcpy(s->path, path);
+    s->rows = rows;
+    s->cols = cols;
+    s->wordCount = (int)(((long)rows * cols + 63) / 64);
+    s->packed = calloc(s->wordCount, sizeof(uint64_t));
+    s->previous = calloc(s->wordCount, sizeof(uint64_t));
+    return s;
+}
+
+static void drop_client(StreamServer *s, int i) {
+    StreamClient *c = &s->clients[i];
+    close(c->fd);
+    frame_unref(c->pending);
+    free(c->baseline);
+    s->clients[i] = s->clients[--s->clientCount];
+}
+
+void stream_server_destroy(StreamServer *server) {
+    if (!server) return;
+    while (server->clientCount > 0) drop_client(server, 0);
+    frame_unref(server->delta);
+    frame_unref(server->snapshot);
+    close(server->listenFd);
+    unlink(server->path);
+    free(server->packed);
+    free(server->previous);
+    free(server);
+}
+
+static StreamFrame *shared_snapshot(StreamServer *s) {
+    if (!s->snapshot) s->snapshot = encode_snapshot(s->packed, s->wordCount, s->rows, s->cols, s->generation);
+    return frame_ref(s->snapshot);
+}
+
+static StreamFrame *shared_delta(StreamServer *s) {
+    if (!s->delta) s->delta = encode_delta(s->previous, s->packed, s->wordCount, s->rows, s->cols, s->generation);
+    return frame_ref(s->delta);
+}
+
+// Give an idle viewer whatever brings it to the latest published grid
+// (a new viewer gets a snapshot even before the first publish: the grid is all dead until then)
+static void queue_latest(StreamServer *s, StreamClient *c) {
+    if (c->seq == s->seq) return;
+    if (c->seq < 0) {
+        c->pending = shared_snapshot(s);
+    } else if (c->lagging) {
+        // One private delta covering every generation it skipped
+        c->pending = encode_delta(c->baseline, s->packed, s->wordCount, s->rows, s->cols, s->generation);
+        c->lagging = false;
+    } else {
+        c->pending = shared_delta(s);
+    }
+    c->sent = 0;
+    c->seq = s->seq;
+}
+
+// Write as much as the socket takes; returns false if the viewer went away
+static bool flush_client(StreamServer *s, StreamClient *c) {
+    while (true) {
+        if (!c->pending) {
+            queue_latest(s, c);
+            if (!c->pending) return true;
+        }
+        ssize_t n = send(c->fd, c->pending->data + c->sent, c->pending->size - c->sent, MSG_NOSIGNAL);
+        if (n < 0) return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        c->sent += n;
+        if (c->sent < c->pending->size) return true; // Socket buffer full, retry next poll
+        frame_unref(c->pending);
+        c->pending = NULL;
+    }
+}
+
+void stream_server_poll(StreamServer *server) {
+    int fd;
+    while (server->clientCount < STREAM_MAX_CLIENTS && (fd = accept(server->listenFd, NULL, NULL)) != -1) {
+        if (!set_nonblocking(fd)) {
+            close(fd);
+            continue;
+        }
+        server->clients[server->clientCount++] = (StreamClient){ .fd = fd, .seq = -1 };
+    }
+
+    for (int i = server->clientCount - 1; i >= 0; i--) {
+        if (!flush_client(server, &server->clients[i])) drop_client(server, i);
+    }
+}
+
+void stream_server_publish(StreamServer *server, const Grid *grid, int generation) {
+    uint64_t *tmp = server->previous;
+    server->previous = server->packed;
+    server->packed = tmp;
+    pack_grid(grid, server->packed, server->wordCount);
+    server->generation = generation;
+    server->seq++;
+
+    frame_unref(server->delta);
+    frame_unref(server->snapshot);
+    server->delta = NULL;
+    server->snapshot = NULL;
+
+    // Viewers still busy with an older frame keep the grid they'll end up with and catch up later
+    for (int i = 0; i < server->clientCount; i++) {
+        StreamClient *c = &server->clients[i];
+        if (c->pending && !c->lagging && c->seq == server->seq - 1) {
+            if (!c->baseline) c->baseline = malloc(server->wordCount * sizeof(uint64_t));
+            memcpy(c->baseline, server->previous, server->wordCount * sizeof(uint64_t));
+            c->lagging = true;
+        }
+    }
+
+    stream_server_poll(server);
+}
+
+// ---------------------------------------------------------
+// Reader
+// ---------------------------------------------------------
+struct StreamReader {
+    int fd;
+    unsigned char *buffer;
+    size_t used;
+    size_t capacity;
+};
+
+StreamReader *stream_reader_connect(const char *path) {
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+    if (strlen(path) >= sizeof(addr.sun_path)) return NULL;
+    strcpy(addr.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1) return NULL;
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == -1 || !set_nonblocking(fd)) {
+        close(fd);
+        return NULL;
+    }
+
+    StreamReader *r = calloc(1, sizeof(StreamReader));
+    r->fd = fd;
+    r->capacity = 1 << 16;
+    r->buffer = malloc(r->capacity);
+    return r;
+}
+
+void stream_reader_destroy(StreamReader *reader) {
+    if (!reader) return;
+    close(reader->fd);
+    free(reader->buffer);
+    free(reader);
+}
+
+// Toggle every cell whose bit is set in `diff`, the word at index `word`
+static void apply_word(Grid *g, DirtyTiles *dirty, long word, uint64_t diff) {
+    while (diff) {
+        long bit = word * 64 + __builtin_ctzll(diff);
+        int x = (int)(bit / g->cols), y = (int)(bit % g->cols);
+        g->cells[x * g->stride + y] ^= 1;
+        mark_cell_dirty(dirty, x, y);
+        diff &= diff - 1;
+    }
+}
+
+static bool apply_frame(const StreamHeader *h, const unsigned char *payload,
+                        Grid **grid, DirtyTiles **dirty, int *generation) {
+    if (h->magic != STREAM_MAGIC) return false;
+
+    if (h->type == STREAM_FRAME_SNAPSHOT) {
+        if (!*grid || (*grid)->rows != h->rows || (*grid)->cols != h->cols) {
+            destroy_grid(*grid);
+            destroy_dirty_tiles(*dirty);
+            *grid = create_grid(h->rows, h->cols);
+            *dirty = create_dirty_tiles(h->rows, h->cols);
+        }
+        clear_grid(*grid);
+        for (uint32_t w = 0; w < h->payloadSize / sizeof(uint64_t); w++) {
+            uint64_t word;
+            memcpy(&word, payload + w * sizeof(uint64_t), sizeof(word));
+            apply_word(*grid, *dirty, w, word);
+        }
+        mark_all_dirty(*dirty);
+    } else if (h->type == STREAM_FRAME_DELTA) {
+        if (!*grid) return false; // Deltas always follow a snapshot
+        const unsigned char *p = payload, *end = payload + h->payloadSize;
+        long word = 0;
+        while (p < end) {
+            uint32_t run[2];
+            memcpy(run, p, sizeof(run));
+            p += sizeof(run);
+            word += run[0];
+            for (uint32_t i = 0; i < run[1]; i++, word++, p += sizeof(uint64_t)) {
+                uint64_t diff;
+                memcpy(&diff, p, sizeof(diff));
+                apply_word(*grid, *dirty, word, diff);
+            }
+        }
+    } else {
+        return false;
+    }
+
+    *generation = h->generation;
+    return true;
+}
+
+bool stream_reader_update(StreamReader *reader, Grid **grid, DirtyTiles **dirty, int *generation) {
+    bool open = true;
+    while (true) {
+        if (reader->used == reader->capacity) {
+            reader->capacity *= 2;
+            reader->buffer = realloc(reader->buffer, reader->capacity);
+        }
+        ssize_t n = recv(reader->fd, reader->buffer + reader->used, reader->capacity - reader->used, 0);
+        if (n > 0) {
+            reader->used += n;
+            continue;
+        }
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) open = false;
+        break;
+    }
+
+    // Apply every complete frame, keep a trailing partial one for the next call
+    size_t offset = 0;
+    while (reader->used - offset >= sizeof(StreamHeader)) {
+        StreamHeader header;
+        memcpy(&header, reader->buffer + offset, sizeof(header));
+        if (reader->used - offset - sizeof(header) < header.payloadSize) break;
+        if (!apply_frame(&header, reader->buffer + offset + sizeof(header), grid, dirty, generation)) return false;
+        offset += sizeof(header) + header.payloadSize;
+    }
+    memmove(reader->buffer, reader->buffer + offset, reader->used - offset);
+    reader->used -= offset;
+    return open;
+}
@@ -0,0 +1,67 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "game.h"
+
+#define STREAM_DEFAULT_PATH "/tmp/conway.sock"
+#define STREAM_MAX_CLIENTS 16
+#define STREAM_MAGIC 0x4B4E5759u // Sanity check at the start of every header
+
+// Frame kinds sent by the server
+typedef enum {
+ STREAM_FRAME_SNAPSHOT = 1,  // Payload: the whole grid, bit-packed into uint64 words
+ STREAM_FRAME_DELTA = 2      // Payload: runs of XOR words against the previous frame
+} StreamFrameType;
+
+// Header in front of every frame. Host byte order: the socket is local only.
+// Cells are packed row-major, cell (row, col) is bit (row * cols + col) of the word array.
+// A delta payload is a sequence of runs: uint32 skip, uint32 count, then count uint64 XOR words,
+// where skip is the number of unchanged words since the end of the previous run.
+typedef struct {
+ uint32_t magic;
+ uint32_t type;
+ int32_t rows;
+ int32_t cols;
+ int32_t generation;
+ uint32_t payloadSize;  // Bytes following the header
+} StreamHeader;
+
+typedef struct StreamServer StreamServer;
+typedef struct StreamReader StreamReader;
+
+/**
+ * Start listening on a Unix socket at `path` for viewers of a rows x cols grid.
+ * A socket already at `path` is replaced. Returns NULL if the socket could not be created,
+ * or if `path` is some other kind of file.
+ */
+StreamServer *stream_server_create(const char *path, int rows, int cols);
+void stream_server_destroy(StreamServer *server);
+
+/**
+ * Accept new viewers and push pending data to connected ones. Never blocks.
+ */
+void stream_server_poll(StreamServer *server);
+
+/**
+ * Publish a new generation. Viewers that are still sending an older frame are not waited for:
+ * they skip the intermediate generations and get a single coalesced delta once they catch up.
+ */
+void stream_server_publish(StreamServer *server, const Grid *grid, int generation);
+
+/**
+ * Connect to a server listening at `path`. Returns NULL if nobody is listening.
+ */
+StreamReader *stream_reader_connect(const char *path);
+void stream_reader_destroy(StreamReader *reader);
+
+/**
+ * Read whatever the server sent and apply every complete frame to *grid.
+ * The grid (and its dirty tiles) is (re)created when a snapshot has other dimensions.
+ * Changed cells are flagged in *dirty. Returns false once the connection is closed.
+ */
+bool stream_reader_update(StreamReader *reader, Grid **grid, DirtyTiles **dirty, int *generation);
+
+#endif // STREAM_H
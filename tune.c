@@ -0,0 +1,196 @@
+// Kernel autotuner: benchmarks stepping configurations and caches the winner per grid shape and CPU
+#define _POSIX_C_SOURCE 200809L
+#include "tune.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TUNE_LINE_SIZE 512
+
+static const int tileCandidates[] = { 16, 64, 256 };
+
+// Thread counts to try: powers of two, plus the core count itself
+static int next_thread_count(int threads, int cores) {
+    if (threads * 2 <= cores) return threads * 2;
+    return threads < cores ? cores : 0;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// "model name" from /proc/cpuinfo, part of the profile key
+static void cpu_model(char *out, size_t size) {
+    snprintf(out, size, "unknown");
+    FILE *f = fopen("/proc/cpuinfo", "r");
+    if (!f) return;
+    char line[TUNE_LINE_SIZE];
+    while (fgets(line, sizeof(line), f)) {
+        char *colon = strchr(line, ':');
+        if (strncmp(line, "model name", 10) != 0 || !colon) continue;
+        colon += strspn(colon + 1, " \t") + 1;
+        colon[strcspn(colon, "\n")] = '\0';
+        snprintf(out, size, "%s", colon);
+        break;
+    }
+    fclose(f);
+}
+
+static void profile_path(char *out, size_t size) {
+    const char *home = getenv("HOME");
+    if (home && *home) snprintf(out, size, "%s/%s", home, TUNE_PROFILE_NAME);
+    else snprintf(out, size, "%s", TUNE_PROFILE_NAME);
+}
+
+// Profile lines: "rows cols fixedEngine fixedTileRows fixedThreads engine tileRows threads cpu model..."
+// where the fixed settings are the ones the search was limited to (ENGINE_AUTO / TUNE_FREE if searched)
+static bool parse_line(const char *line, int *rows, int *cols, Options *fixed, Options *config, const char **cpu) {
+    int fixedEngine, engine, consumed = 0;
+    if (sscanf(line, "%d %d %d %d %d %d %d %d %n", rows, cols, &fixedEngine, &fixed->tileRows, &fixed->threads,
+               &engine, &config->tileRows, &config->threads, &consumed) != 8 ||
+        fixedEngine < ENGINE_AUTO || fixedEngine >= ENGINE_COUNT ||
+        engine < 0 || engine >= ENGINE_COUNT || config->tileRows < 1 || config->threads < 1) {
+        return false;
+    }
+    fixed->engine = fixedEngine;
+    config->engine = engine;
+    *cpu = line + consumed;
+    return true;
+}
+
+// Whether a profile line is for this grid shape, CPU and set of fixed settings
+static bool same_key(int rows, int cols, const Options *fixed, const char *cpu,
+                     int lineRows, int lineCols, const Options *lineFixed, const char *lineCpu) {
+    return lineRows == rows && lineCols == cols && lineFixed->engine == fixed->engine &&
+           lineFixed->tileRows == fixed->tileRows && lineFixed->threads == fixed->threads &&
+           strcmp(lineCpu, cpu) == 0;
+}
+
+static bool load_profile(int rows, int cols, const char *cpu, Options *options) {
+    char path[TUNE_LINE_SIZE], line[TUNE_LINE_SIZE];
+    profile_path(path, sizeof(path));
+    FILE *f = fopen(path, "r");
+    if (!f) return false;
+
+    bool found = false;
+    while (!found && fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\n")] = '\0';
+        int r, c;
+        Options fixed, config;
+        const char *lineCpu;
+        if (parse_line(line, &r, &c, &fixed, &config, &lineCpu) &&
+            same_key(rows, cols, options, cpu, r, c, &fixed, lineCpu)) {
+            options->engine = config.engine;
+            options->tileRows = config.tileRows;
+            options->threads = config.threads;
+            found = true;
+        }
+    }
+    fclose(f);
+    return found;
+}
+
+// Rewrite the profile with this shape's entry replaced (or added)
+static void save_profile(int rows, int cols, const char *cpu, const Options *fixed, const Options *options) {
+    char path[TUNE_LINE_SIZE], tmpPath[TUNE_LINE_SIZE + 8], line[TUNE_LINE_SIZE];
+    profile_path(path, sizeof(path));
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+    FILE *out = fopen(tmpPath, "w");
+    if (!out) return;
+
+    FILE *in = fopen(path, "r");
+    if (in) {
+        while (fgets(line, sizeof(line), in)) {
+            char key[TUNE_LINE_SIZE];
+            snprintf(key, sizeof(key), "%s", line);
+            key[strcspn(key, "\n")] = '\0';
+            int r, c;
+            Options lineFixed, config;
+            const char *lineCpu;
+            if (!parse_line(key, &r, &c, &lineFixed, &config, &lineCpu)) continue; // Drop garbage
+            if (same_key(rows, cols, fixed, cpu, r, c, &lineFixed, lineCpu)) continue;
+            fputs(line, out);
+        }
+        fclose(in);
+    }
+    fprintf(out, "%d %d %d %d %d %d %d %d %s\n", rows, cols, fixed->engine, fixed->tileRows, fixed->threads,
+            options->engine, options->tileRows, options->threads, cpu);
+    fclose(out);
+    rename(tmpPath, path);
+}
+
+// Average seconds per generation of one configuration, stepping for about TUNE_CANDIDATE_SECONDS
+static double benchmark(Grid **current, Grid **next, Options config) {
+    step_generation(*current, *next, config, NULL); // Warm up caches and thread startup paths
+    int steps = 0;
+    double start = now_seconds(), elapsed;
+    do {
+        step_generation(*current, *next, config, NULL);
+        Grid *temp = *current;
+        *current = *next;
+        *next = temp;
+        steps++;
+        elapsed = now_seconds() - start;
+    } while (elapsed < TUNE_CANDIDATE_SECONDS);
+    return elapsed / steps;
+}
+
+void autotune(int rows, int cols, Options *options, bool retune) {
+    Options fixed = *options;
+    if (fixed.engine != ENGINE_AUTO && fixed.tileRows != TUNE_FREE && fixed.threads != TUNE_FREE) return;
+    char cpu[TUNE_LINE_SIZE];
+    cpu_model(cpu, sizeof(cpu));
+    if (!retune && load_profile(rows, cols, cpu, options)) return;
+
+    init_lut_kernel();
+    Grid *current = create_grid(rows, cols);
+    Grid *next = create_grid(rows, cols);
+    randomize_grid(current);
+
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 1) cores = 1;
+    if (cores > MAX_STEP_THREADS) cores = MAX_STEP_THREADS;
+
+    // Candidates for each setting: just the fixed value, or the whole range
+    bool freeEngine = fixed.engine == ENGINE_AUTO, freeThreads = fixed.threads == TUNE_FREE;
+    int engineFirst = freeEngine ? 0 : fixed.engine;
+    int engineLast = freeEngine ? ENGINE_COUNT - 1 : fixed.engine;
+    const int *tiles = tileCandidates;
+    int tileCount = (int)(sizeof(tileCandidates) / sizeof(tileCandidates[0]));
+    if (fixed.tileRows != TUNE_FREE) {
+        tiles = &fixed.tileRows;
+        tileCount = 1;
+    }
+
+    Options best = fixed, config = fixed;
+    double bestTime = -1.0;
+    for (int e = engineFirst; e <= engineLast; e++) {
+        for (int t = 0; t < tileCount; t++) {
+            int bands = (rows + tiles[t] - 1) / tiles[t];
+            if (t > 0 && tiles[t - 1] >= rows) break; // Bigger bands behave the same
+            for (int threads = freeThreads ? 1 : fixed.threads; threads;
+                 threads = freeThreads ? next_thread_count(threads, cores) : 0) {
+                if (freeThreads && threads > bands) break;
+                config.engine = e;
+                config.tileRows = tiles[t];
+                config.threads = threads;
+                double time = benchmark(&current, &next, config);
+                if (bestTime < 0 || time < bestTime) {
+                    bestTime = time;
+                    best = config;
+                }
+            }
+        }
+    }
+
+    destroy_grid(current);
+    destroy_grid(next);
+    options->engine = best.engine;
+    options->tileRows = best.tileRows;
+    options->threads = best.threads;
+    save_profile(rows, cols, cpu, &fixed, options);
+}
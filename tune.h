@@ -0,0 +1,21 @@
+#ifndef TUNE_H
+#define TUNE_H
+
+#include <stdbool.h>
+
+#include "game.h"
+
+#define TUNE_PROFILE_NAME ".conway_tune"  // Kept in $HOME (or the working directory without one)
+#define TUNE_CANDIDATE_SECONDS 0.003      // Time each configuration is benchmarked for
+#define TUNE_FREE -1                      // Band size or thread count left for autotune to pick
+
+/**
+ * Pick the fastest engine, band size and thread count for a rows x cols grid on this CPU.
+ * Only options->engine when it is ENGINE_AUTO and options->tileRows and options->threads when
+ * they are TUNE_FREE are searched, the others stay fixed. Uses the cached winner for the same fixed settings
+ * from the on-disk profile when there is one, otherwise (or when `retune` is set)
+ * benchmarks every candidate and stores the winner.
+ */
+void autotune(int rows, int cols, Options *options, bool retune);
+
+#endif // TUNE_H
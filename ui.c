@@ -14,12 +14,13 @@ static Color gridColor       = (Color){ 255, 255, 255, 20 };
 static Color aliveCellColor  = (Color){ 200, 255, 255, 200 };
 static Color deadCellColor   = (Color){ 255, 255, 255, 10 };
 static Color textColor       = LIGHTGRAY;
+static Color panelColor      = (Color){ 30, 30, 30, 150 };
 
 #define MIN_CELL_SIZE 1
 #define MAX_CELL_SIZE 100
 
 static inline int idx(const Grid *g, int row, int col) {
-    return row * g->cols + col;
+    return row * g->stride + col;
 }
 
 
@@ -134,8 +135,39 @@ int calculate_cell_size(int rows, int cols) {
     return cellSize;
 }
 
+// Persistent render target holding the drawn grid, only dirty tiles get redrawn into it
+static RenderTexture2D gridTexture;
+static int gridTextureRows = 0;
+static int gridTextureCols = 0;
+static int gridTextureCellSize = 0;
+
+// Redraw the cells of one tile into the grid texture (must be inside BeginTextureMode)
+static void draw_tile(const Grid *grid, int tileRow, int tileCol, int cellSize) {
+    // The texture is blitted opaque, so pre-blend the translucent colors over the panel shade
+    Color panel = ColorAlphaBlend(backgroundColor, panelColor, WHITE);
+    Color alive = ColorAlphaBlend(panel, aliveCellColor, WHITE);
+    Color dead  = ColorAlphaBlend(panel, deadCellColor, WHITE);
+    Color lines = ColorAlphaBlend(dead, gridColor, WHITE);
+
+    int rowEnd = fminf((tileRow + 1) * DIRTY_TILE_SIZE, grid->rows);
+    int colEnd = fminf((tileCol + 1) * DIRTY_TILE_SIZE, grid->cols);
+    for (int i = tileRow * DIRTY_TILE_SIZE; i < rowEnd; i++) {
+        for (int j = tileCol * DIRTY_TILE_SIZE; j < colEnd; j++) {
+            int x = j * cellSize;
+            int y = i * cellSize;
+
+            if (grid->cells[idx(grid, i, j)] != 0) {
+                DrawRectangle(x, y, cellSize, cellSize, alive);
+            } else {
+                DrawRectangle(x, y, cellSize, cellSize, dead);
+                DrawRectangleLines(x, y, cellSize, cellSize, lines);
+            }
+        }
+    }
+}
+
 // Draw grid
-static void draw_grid(const Grid *grid, int cellSize) {
+static void draw_grid(const Grid *grid, int cellSize, DirtyTiles *dirty) {
     // Calculate the maximum width and height for the grid to fit within screenWidth / 2
     int maxWidth = GetScreenWidth() / 2;
     int maxHeight = GetScreenHeight();
@@ -154,26 +186,37 @@ static void draw_grid(const Grid *grid, int cellSize) {
     int offsetY = (maxHeight - gridHeight) / 2;
 
     // Darken the left part of the screen
-    DrawRectangle(0, 0, maxWidth, maxHeight, (Color){30, 30, 30, 150});
-
-    // Draw the grid
-    for (int i = 0; i < grid->rows; i++) {
-        for (int j = 0; j < grid->cols; j++) {
-            int index = idx(grid, i, j);
-            bool isAlive = (grid->cells[index] != 0);
-
-            // Calculate the position of each cell with the offsets
-            int x = offsetX + j * adjustedCellSize;
-            int y = offsetY + i * adjustedCellSize;
+    DrawRectangle(0, 0, maxWidth, maxHeight, panelColor);
+
+    if (adjustedCellSize < 1) return; // Window too small to show a single pixel per cell
+
+    // (Re)create the texture when the layout changed, everything has to be redrawn then
+    if (gridTextureRows != grid->rows || gridTextureCols != grid->cols ||
+        gridTextureCellSize != adjustedCellSize) {
+        if (gridTextureCellSize != 0) UnloadRenderTexture(gridTexture);
+        gridTexture = LoadRenderTexture(gridWidth, gridHeight);
+        gridTextureRows = grid->rows;
+        gridTextureCols = grid->cols;
+        gridTextureCellSize = adjustedCellSize;
+        mark_all_dirty(dirty);
+    }
 
-            if (isAlive) {
-                DrawRectangle(x, y, adjustedCellSize, adjustedCellSize, aliveCellColor);
-            } else {
-                DrawRectangle(x, y, adjustedCellSize, adjustedCellSize, deadCellColor);
-                DrawRectangleLines(x, y, adjustedCellSize, adjustedCellSize, gridColor);
-            }
+    // Redraw only the tiles that changed since the last frame
+    bool textureMode = false;
+    for (int t = 0; t < dirty->tileRows * dirty->tileCols; t++) {
+        if (!dirty->tiles[t]) continue;
+        if (!textureMode) {
+            BeginTextureMode(gridTexture);
+            textureMode = true;
         }
+        draw_tile(grid, t / dirty->tileCols, t % dirty->tileCols, adjustedCellSize);
+        dirty->tiles[t] = 0;
     }
+    if (textureMode) EndTextureMode();
+
+    // Render textures are stored upside down, hence the negative source height
+    DrawTextureRec(gridTexture.texture, (Rectangle){ 0, 0, gridWidth, -gridHeight },
+                   (Vector2){ offsetX, offsetY }, WHITE);
 }
 
 bool handle_restart(Grid **current, Grid **next, Grid **historyStates, int *rows, int *cols, int *cellSize) {
@@ -207,7 +250,7 @@ bool handle_restart(Grid **current, Grid **next, Grid **historyStates, int *rows
     return false;  // No restart occurred
 }
 
-bool handle_menu_input(Grid *grid, Options *options, int *cellSize) {
+bool handle_menu_input(Grid *grid, Options *options, int *cellSize, DirtyTiles *dirty) {
     static int lastPaintedX = -1;
     static int lastPaintedY = -1;
     bool startSimulation = false;
@@ -227,6 +270,7 @@ bool handle_menu_input(Grid *grid, Options *options, int *cellSize) {
             int index = idx(grid, x, y);
             // Toggle cell state
             grid->cells[index] = !grid->cells[index];
+            mark_cell_dirty(dirty, x, y);
             lastPaintedX = x;
             lastPaintedY = y;
             }
@@ -239,11 +283,13 @@ bool handle_menu_input(Grid *grid, Options *options, int *cellSize) {
     // Randomize
     if (IsKeyPressed(KEY_R)) {
         randomize_grid(grid);
+        mark_all_dirty(dirty);
     }
 
     // Clear
     if (IsKeyPressed(KEY_C)) {
         clear_grid(grid);
+        mark_all_dirty(dirty);
     }
 
     // Start simulation
@@ -254,6 +300,8 @@ bool handle_menu_input(Grid *grid, Options *options, int *cellSize) {
     // Toggle options
     if (IsKeyPressed(KEY_ONE)) options->stopOnGliding = !options->stopOnGliding;
     if (IsKeyPressed(KEY_TWO)) options->stopOnLooping = !options->stopOnLooping;
+    if (IsKeyPressed(KEY_THREE)) options->boundary = (options->boundary + 1) % BOUNDARY_COUNT;
+    if (IsKeyPressed(KEY_FOUR)) options->engine = (options->engine + 1) % ENGINE_COUNT;
 
 
 
@@ -263,9 +311,9 @@ bool handle_menu_input(Grid *grid, Options *options, int *cellSize) {
 
 
 
-void draw_menu_ui(const Grid *grid, Options options, int cellSize) {
+void draw_menu_ui(const Grid *grid, Options options, int cellSize, DirtyTiles *dirty) {
     // Draw the grid within the left half of the screen
-    draw_grid(grid, cellSize);
+    draw_grid(grid, cellSize, dirty);
 
     // Draw the text within the right half of the screen
     int textStartX = GetScreenWidth() / 2 + 40;
@@ -295,28 +343,43 @@ void draw_menu_ui(const Grid *grid, Options options, int cellSize) {
 
 
     // Options Title
-    DrawText("Options:", textStartX, 400, 26, WHITE);
+    DrawText("Options:", textStartX, 360, 26, WHITE);
 
     // [1]: Stop on Gliding
-    DrawText("[", textStartX, 440, 20, textColor);
-    DrawText("1", textStartX + 10, 440, 20, SKYBLUE);
-    DrawText("]: Stop on Gliding: ", textStartX + 22, 440, 20, textColor);
-    DrawText(options.stopOnGliding ? "ON" : "OFF", textStartX + 250, 440, 20,
+    DrawText("[", textStartX, 400, 20, textColor);
+    DrawText("1", textStartX + 10, 400, 20, SKYBLUE);
+    DrawText("]: Stop on Gliding: ", textStartX + 22, 400, 20, textColor);
+    DrawText(options.stopOnGliding ? "ON" : "OFF", textStartX + 250, 400, 20,
              options.stopOnGliding ? GREEN : RED);
 
     // [2]: Stop on Looping
-    DrawText("[", textStartX, 480, 20, textColor);
-    DrawText("2", textStartX + 10, 480, 20, SKYBLUE);
-    DrawText("]: Stop on Looping: ", textStartX + 27, 480, 20, textColor);
-    DrawText(options.stopOnLooping ? "ON" : "OFF", textStartX + 250, 480, 20,
+    DrawText("[", textStartX, 440, 20, textColor);
+    DrawText("2", textStartX + 10, 440, 20, SKYBLUE);
+    DrawText("]: Stop on Looping: ", textStartX + 27, 440, 20, textColor);
+    DrawText(options.stopOnLooping ? "ON" : "OFF", textStartX + 250, 440, 20,
              options.stopOnLooping ? GREEN : RED);
+
+    // [3]: Boundary mode
+    static const char *boundaryNames[BOUNDARY_COUNT] = { "TORUS", "DEAD", "MIRROR" };
+    DrawText("[", textStartX, 480, 20, textColor);
+    DrawText("3", textStartX + 10, 480, 20, SKYBLUE);
+    DrawText("]: Boundary: ", textStartX + 27, 480, 20, textColor);
+    DrawText(boundaryNames[options.boundary], textStartX + 250, 480, 20, SKYBLUE);
+
+    // [4]: Stepping engine
+    static const char *engineNames[ENGINE_COUNT] = { "NAIVE", "LOOKUP TABLE" };
+    DrawText("[", textStartX, 520, 20, textColor);
+    DrawText("4", textStartX + 10, 520, 20, SKYBLUE);
+    DrawText("]: Engine: ", textStartX + 27, 520, 20, textColor);
+    DrawText(TextFormat("%s x%d", engineNames[options.engine], options.threads), textStartX + 250, 520, 20, SKYBLUE);
 }
 
 
 void draw_simulation_ui(const Grid *grid, int generation, bool paused, bool running,
-                     float simulationSpeed, int detection, int cellSize)
+                     float simulationSpeed, int detection, int cellSize, DirtyTiles *dirty,
+                     const Census *census)
 {
-    draw_grid(grid, cellSize);
+    draw_grid(grid, cellSize, dirty);
 
     // Info text
     DrawText(TextFormat("Generation: %d", generation), GetScreenWidth()/2 + 40, 30, 30, RAYWHITE);
@@ -345,6 +408,32 @@ void draw_simulation_ui(const Grid *grid, int generation, bool paused, bool runn
         DrawText("Press R to restart simulation or ESC to exit",
                  GetScreenWidth()/2 + 40, 280, 20, GREEN);
     }
+
+    if (census) {
+        const CensusEntry *entries[6];
+        int count = census_summary(census, entries, 6);
+        DrawText(TextFormat("Census: %d objects", census_object_count(census)),
+                 GetScreenWidth()/2 + 40, 340, 20, RAYWHITE);
+        for (int i = 0; i < count; i++) {
+            DrawText(TextFormat("%4d x %.32s", entries[i]->count, entries[i]->name ? entries[i]->name : entries[i]->code),
+                     GetScreenWidth()/2 + 40, 370 + i * 25, 20, textColor);
+        }
+    }
+}
+
+void draw_viewer_ui(const Grid *grid, int generation, bool connected, int cellSize, DirtyTiles *dirty) {
+    if (grid) draw_grid(grid, cellSize, dirty);
+
+    int textStartX = GetScreenWidth() / 2 + 40;
+    if (grid) DrawText(TextFormat("Generation: %d", generation), textStartX, 30, 30, RAYWHITE);
+    if (!connected) {
+        DrawText("DISCONNECTED (Server closed the stream)", textStartX, 100, 20, RED);
+    } else if (!grid) {
+        DrawText("Waiting for the first snapshot...", textStartX, 100, 20, textColor);
+    } else {
+        DrawText("LIVE (Streaming from server)", textStartX, 100, 20, GREEN);
+    }
+    DrawText("Press ESC to exit", textStartX, 160, 20, textColor);
 }
 
 void draw_signature(void) {
@@ -1,6 +1,7 @@
 #ifndef UI_H
 #define UI_H
 
+#include "census.h"
 #include "game.h"
 
 /**
@@ -17,19 +18,28 @@ bool select_resolution_if_needed(int *rows, int *cols, bool resolutionProvided);
 
 /**
  * Draw the menu (the place where user can paint cells, randomize, etc.).
+ * Only the tiles flagged in `dirty` are redrawn; the flags are cleared afterwards.
  */
-void draw_menu_ui(const Grid *grid, Options options, int cellSize);
+void draw_menu_ui(const Grid *grid, Options options, int cellSize, DirtyTiles *dirty);
 
 /**
  * Handle user input in the menu (like toggling cells with mouse, randomize, clear, etc.).
+ * Edited cells are flagged in `dirty`.
  * Returns true if user wants to start the simulation, false otherwise.
  */
-bool handle_menu_input(Grid *grid, Options *options, int *cellSize);
+bool handle_menu_input(Grid *grid, Options *options, int *cellSize, DirtyTiles *dirty);
 
 /**
  * Draw the simulation interface: draw the cells, generation info, paused/running state, etc.
+ * Only the tiles flagged in `dirty` are redrawn; the flags are cleared afterwards.
+ * If `census` is not NULL, the most common objects on the board are listed too.
  */
-void draw_simulation_ui(const Grid *grid, int generation, bool paused, bool running, float simulationSpeed, int detection, int cellSize);
+void draw_simulation_ui(const Grid *grid, int generation, bool paused, bool running, float simulationSpeed, int detection, int cellSize, DirtyTiles *dirty, const Census *census);
+
+/**
+ * Draw the remote viewer interface: the streamed grid (if any yet) and the connection state.
+ */
+void draw_viewer_ui(const Grid *grid, int generation, bool connected, int cellSize, DirtyTiles *dirty);
 
 /**
  * Adjust the cellSize based on the current window height.
@@ -0,0 +1,49 @@
+#include <raylib.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "game.h"
+#include "stream.h"
+#include "ui.h"
+
+// Remote viewer: mirrors the grid streamed by `conway --serve`
+int main(int argc, char *argv[]) {
+    const char *path = argc > 1 ? argv[1] : STREAM_DEFAULT_PATH;
+    StreamReader *reader = stream_reader_connect(path);
+    if (!reader) {
+        fprintf(stderr, "Could not connect to %s (is conway running with --serve?)\n", path);
+        return 1;
+    }
+
+    SetConfigFlags(FLAG_WINDOW_RESIZABLE | FLAG_WINDOW_UNDECORATED);
+    InitWindow(1200, 600, "Conway's Game of Life - Viewer");
+    SetTargetFPS(60);
+
+    Grid *grid = NULL;
+    DirtyTiles *dirty = NULL;
+    int generation = 0;
+    int cellSize = 0;
+    bool connected = true;
+
+    while (!WindowShouldClose()) {
+        if (connected) {
+            int rows = grid ? grid->rows : 0, cols = grid ? grid->cols : 0;
+            connected = stream_reader_update(reader, &grid, &dirty, &generation);
+            if (grid && (grid->rows != rows || grid->cols != cols)) {
+                cellSize = calculate_cell_size(grid->rows, grid->cols);
+            }
+        }
+
+        BeginDrawing();
+        ClearBackground(BLACK);
+        draw_viewer_ui(grid, generation, connected, cellSize, dirty);
+        draw_signature();
+        EndDrawing();
+    }
+
+    destroy_grid(grid);
+    destroy_dirty_tiles(dirty);
+    stream_reader_destroy(reader);
+    CloseWindow();
+    return 0;
+}